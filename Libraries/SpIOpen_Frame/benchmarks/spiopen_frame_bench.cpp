@@ -0,0 +1,652 @@
+#include <benchmark/benchmark.h>
+#include <etl/byte_stream.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "spiopen_frame.h"
+#include "spiopen_frame_algorithms.h"
+#include "spiopen_frame_format.h"
+#include "spiopen_frame_reader.h"
+#include "spiopen_frame_shape.h"
+#include "spiopen_frame_view.h"
+#include "spiopen_frame_writer.h"
+#include "../tests/spiopen_frame_test_helpers.h"
+
+#ifndef SPIOPEN_FRAME_BENCH_ALGORITHM_BACKEND
+#define SPIOPEN_FRAME_BENCH_ALGORITHM_BACKEND "unknown"
+#endif
+
+using namespace spiopen;
+using namespace spiopen::format;
+using namespace spiopen::test_helpers;
+
+namespace {
+
+// Flag combinations are passed as a bitmask argument so every combination shows up as its own benchmark
+constexpr int64_t kFlagIde = 1;
+constexpr int64_t kFlagTtl = 2;
+constexpr int64_t kFlagWa = 4;
+constexpr int64_t kAllFlagCombinations = 8;
+constexpr int64_t kFlagDwa = 8;  // wide alignment only, not part of the combinations above
+
+// Payload sizes covering CC, FD and XL frames. 2047 is the largest length the 11-bit XL length field encodes.
+const std::vector<int64_t> kPayloadSizes = {0, 8, 64, 512, 2047};
+
+struct EncodedFrame {
+    std::vector<uint8_t> payload;
+    Frame frame{};
+    std::vector<uint8_t> wire;
+};
+
+const char* FrameTypeLabel(const Frame& frame) {
+    if (frame.can_flags.XLF) {
+        return "XL";
+    }
+    return frame.can_flags.FDF ? "FD" : "CC";
+}
+
+// Build and encode a frame, choosing the smallest frame type that fits the payload
+bool BuildFrame(const size_t payload_size, const int64_t flags, EncodedFrame& out) {
+    out.payload.resize(payload_size);
+    for (size_t i = 0U; i < payload_size; ++i) {
+        out.payload[i] = static_cast<uint8_t>((i * 13U) ^ (i >> 4U));
+    }
+    out.frame = Frame{};
+    out.frame.can_flags.IDE = (flags & kFlagIde) != 0 ? 1 : 0;
+    out.frame.can_flags.TTL = (flags & kFlagTtl) != 0 ? 1 : 0;
+    out.frame.can_flags.WA = (flags & kFlagWa) != 0 ? 1 : 0;
+    out.frame.can_flags.DWA = (flags & kFlagDwa) != 0 ? 1 : 0;
+    out.frame.can_flags.FDF = (payload_size > MAX_CC_PAYLOAD_SIZE) ? 1 : 0;
+    out.frame.can_flags.XLF = (payload_size > MAX_FD_PAYLOAD_SIZE) ? 1 : 0;
+    out.frame.can_identifier = out.frame.can_flags.IDE ? 0x0ABCDEFU : 0x2AU;
+    out.frame.time_to_live = 200U;
+    out.frame.payload = etl::span<uint8_t>(out.payload.data(), out.payload.size());
+
+    out.wire = EncodeFrame(out.frame);
+    return !out.wire.empty();
+}
+
+void SetFrameCounters(benchmark::State& state, const EncodedFrame& encoded) {
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(encoded.wire.size()));
+    state.counters["frame_bytes"] = static_cast<double>(encoded.wire.size());
+    state.SetLabel(FrameTypeLabel(encoded.frame));
+}
+
+// --- Frame reader / writer ---
+
+void BM_WriteFrame(benchmark::State& state) {
+    EncodedFrame encoded;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), state.range(1), encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    std::vector<uint8_t> buffer(MAX_CAN_XL_FRAME_SIZE);
+    for (auto _ : state) {
+        etl::byte_stream_writer writer(etl::span<uint8_t>(buffer.data(), buffer.size()), etl::endian::big);
+        auto ret = frame_writer::WriteFrame(writer, encoded.frame);
+        benchmark::DoNotOptimize(ret);
+        benchmark::ClobberMemory();
+    }
+    SetFrameCounters(state, encoded);
+}
+BENCHMARK(BM_WriteFrame)->ArgsProduct({kPayloadSizes, benchmark::CreateDenseRange(0, kAllFlagCombinations - 1, 1)});
+
+void BM_WriteFrameTemplate(benchmark::State& state) {
+    EncodedFrame encoded;
+    frame_writer::CyclicFrameTemplate frame_template;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), state.range(1), encoded) ||
+        !frame_writer::PrepareFrameTemplate(encoded.frame, frame_template)) {
+        state.SkipWithError("PrepareFrameTemplate failed");
+        return;
+    }
+    const etl::span<const uint8_t> payload(encoded.payload.data(), encoded.payload.size());
+    std::vector<uint8_t> buffer(MAX_CAN_XL_FRAME_SIZE);
+    for (auto _ : state) {
+        etl::byte_stream_writer writer(etl::span<uint8_t>(buffer.data(), buffer.size()), etl::endian::big);
+        auto ret = frame_writer::WriteFrame(writer, frame_template, payload);
+        benchmark::DoNotOptimize(ret);
+        benchmark::ClobberMemory();
+    }
+    SetFrameCounters(state, encoded);
+}
+BENCHMARK(BM_WriteFrameTemplate)->ArgsProduct({kPayloadSizes, {0, kFlagIde | kFlagTtl | kFlagWa}});
+
+void BM_WriteFrameSegments(benchmark::State& state) {
+    EncodedFrame encoded;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), state.range(1), encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    for (auto _ : state) {
+        frame_writer::FrameSegments segments;
+        auto ret = frame_writer::WriteFrameSegments(encoded.frame, segments);
+        benchmark::DoNotOptimize(ret);
+        benchmark::DoNotOptimize(segments);
+        benchmark::ClobberMemory();
+    }
+    SetFrameCounters(state, encoded);
+}
+BENCHMARK(BM_WriteFrameSegments)->ArgsProduct({kPayloadSizes, {0, kFlagWa}});
+
+// One SPI burst of 32 frames, written with WriteFrames() (1) or WriteFrame() in a loop (0)
+void BM_WriteFrames(benchmark::State& state) {
+    constexpr size_t kBurstFrames = 32U;
+    EncodedFrame encoded;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), kFlagWa, encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    const std::vector<Frame> frames(kBurstFrames, encoded.frame);
+    std::vector<size_t> offsets(kBurstFrames);
+    std::vector<uint8_t> buffer(kBurstFrames * (encoded.wire.size() + 4U));
+    const bool batched = state.range(1) != 0;
+    for (auto _ : state) {
+        etl::byte_stream_writer writer(etl::span<uint8_t>(buffer.data(), buffer.size()), etl::endian::big);
+        if (batched) {
+            auto ret = frame_writer::WriteFrames(writer, etl::span<const Frame>(frames.data(), frames.size()),
+                                                 etl::span<size_t>(offsets.data(), offsets.size()),
+                                                 frame_writer::BatchWriteOptions{4U, 0U, 0x00U});
+            benchmark::DoNotOptimize(ret);
+        } else {
+            for (size_t i = 0U; i < kBurstFrames; ++i) {
+                offsets[i] = writer.size_bytes();
+                if (!frame_writer::WriteFrame(writer, frames[i])) {
+                    break;
+                }
+                while ((writer.size_bytes() % 4U) != 0U) {
+                    writer.write(static_cast<uint8_t>(0U));
+                }
+            }
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kBurstFrames));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * kBurstFrames * encoded.wire.size()));
+    state.SetLabel(FrameTypeLabel(encoded.frame));
+}
+BENCHMARK(BM_WriteFrames)->ArgsProduct({{0, 8, 64}, {0, 1}});
+
+// The fixed-shape entry points against the generic ones, for an 8-byte CC frame and a 64-byte FD frame (0 = generic,
+// 1 = shaped)
+template <typename Shape>
+void BM_WriteShapedFrame(benchmark::State& state) {
+    EncodedFrame encoded;
+    if (!BuildFrame(Shape::PAYLOAD_SIZE, 0, encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    const bool shaped = state.range(0) != 0;
+    std::vector<uint8_t> buffer(MAX_CAN_XL_FRAME_SIZE);
+    for (auto _ : state) {
+        etl::byte_stream_writer writer(etl::span<uint8_t>(buffer.data(), buffer.size()), etl::endian::big);
+        auto ret = shaped ? frame_writer::WriteShapedFrame<Shape>(writer, encoded.frame)
+                          : frame_writer::WriteFrame(writer, encoded.frame);
+        benchmark::DoNotOptimize(ret);
+        benchmark::ClobberMemory();
+    }
+    SetFrameCounters(state, encoded);
+}
+BENCHMARK_TEMPLATE(BM_WriteShapedFrame, FrameShape<8U>)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_WriteShapedFrame, FrameShape<64U>)->Arg(0)->Arg(1);
+
+template <typename Shape>
+void BM_ReadShapedFrame(benchmark::State& state) {
+    EncodedFrame encoded;
+    if (!BuildFrame(Shape::PAYLOAD_SIZE, 0, encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    const bool shaped = state.range(0) != 0;
+    for (auto _ : state) {
+        etl::byte_stream_reader reader(encoded.wire.data(), encoded.wire.size(), etl::endian::big);
+        Frame frame{};
+        auto ret =
+            shaped ? frame_reader::ReadShapedFrame<Shape>(reader, frame) : frame_reader::ReadFrame(reader, frame);
+        benchmark::DoNotOptimize(ret);
+        benchmark::DoNotOptimize(frame);
+    }
+    SetFrameCounters(state, encoded);
+}
+BENCHMARK_TEMPLATE(BM_ReadShapedFrame, FrameShape<8U>)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_ReadShapedFrame, FrameShape<64U>)->Arg(0)->Arg(1);
+
+// Write a frame and push it into a 32-bit DMA FIFO: whole words while they last, then the tail one byte at a time
+// (the slow path on FIFOs that only take word writes). Alignment 4 and 8 frames, with the wide alignment option, never
+// have a byte tail.
+void BM_WriteFrameToWordFifo(benchmark::State& state) {
+    const int64_t alignment = state.range(1);
+    const int64_t flags = ((alignment == 2 || alignment == 8) ? kFlagWa : 0) | ((alignment >= 4) ? kFlagDwa : 0);
+    EncodedFrame encoded;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), flags, encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    alignas(4) uint8_t buffer[MAX_CAN_FD_FRAME_SIZE];
+    int64_t fifo_writes = 0;
+    for (auto _ : state) {
+        etl::byte_stream_writer writer(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+        if (!frame_writer::WriteFrame(writer, encoded.frame)) {
+            state.SkipWithError("WriteFrame failed");
+            return;
+        }
+        const size_t length = writer.size_bytes();
+        size_t i = 0U;
+        for (; i + 4U <= length; i += 4U) {
+            uint32_t word;
+            std::memcpy(&word, buffer + i, sizeof(word));
+            benchmark::DoNotOptimize(word);
+            ++fifo_writes;
+        }
+        for (; i < length; ++i) {
+            benchmark::DoNotOptimize(buffer[i]);
+            ++fifo_writes;
+        }
+    }
+    SetFrameCounters(state, encoded);
+    // bus transfers per frame, which is what a word-only FIFO pays for on the target
+    state.counters["fifo_writes"] =
+        benchmark::Counter(static_cast<double>(fifo_writes), benchmark::Counter::kAvgIterations);
+}
+#ifdef CONFIG_SPIOPEN_FRAME_WIDE_ALIGNMENT_ENABLE
+BENCHMARK(BM_WriteFrameToWordFifo)->ArgsProduct({{0, 5, 8, 64}, {1, 2, 4, 8}});
+#else
+BENCHMARK(BM_WriteFrameToWordFifo)->ArgsProduct({{0, 5, 8, 64}, {1, 2}});
+#endif
+
+void BM_ReadFrame(benchmark::State& state) {
+    EncodedFrame encoded;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), state.range(1), encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    Frame frame{};
+    for (auto _ : state) {
+        etl::byte_stream_reader reader(encoded.wire.data(), encoded.wire.size(), etl::endian::big);
+        auto ret = frame_reader::ReadFrame(reader, frame);
+        if (!ret) {
+            state.SkipWithError("ReadFrame failed");
+            break;
+        }
+        benchmark::DoNotOptimize(frame);
+    }
+    SetFrameCounters(state, encoded);
+}
+BENCHMARK(BM_ReadFrame)->ArgsProduct({kPayloadSizes, benchmark::CreateDenseRange(0, kAllFlagCombinations - 1, 1)});
+
+// Validate the same frames as BM_ReadFrame but only decode the CAN identifier, as a router deciding where a frame goes
+void BM_ReadFrameView(benchmark::State& state) {
+    EncodedFrame encoded;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), state.range(1), encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    frame_reader::FrameView view;
+    for (auto _ : state) {
+        etl::byte_stream_reader reader(encoded.wire.data(), encoded.wire.size(), etl::endian::big);
+        auto ret = frame_reader::ReadFrameView(reader, view);
+        if (!ret) {
+            state.SkipWithError("ReadFrameView failed");
+            break;
+        }
+        benchmark::DoNotOptimize(view.GetCanIdentifier());
+    }
+    SetFrameCounters(state, encoded);
+}
+BENCHMARK(BM_ReadFrameView)->ArgsProduct({kPayloadSizes, benchmark::CreateDenseRange(0, kAllFlagCombinations - 1, 1)});
+
+// Work out the frame length from the first bytes received, as a receiver programming its second DMA transfer would
+void BM_PeekFrameLength(benchmark::State& state) {
+    EncodedFrame encoded;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), kFlagIde | kFlagTtl | kFlagWa, encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    const uint8_t bit_slip_count = static_cast<uint8_t>(state.range(1));
+    const std::vector<uint8_t> slipped = BitSlip(encoded.wire, bit_slip_count);
+    const etl::span<const uint8_t> prefix(slipped.data(), LENGTH_PREFIX_SIZE + 1U);
+    for (auto _ : state) {
+        auto ret = frame_reader::PeekFrameLength(prefix, bit_slip_count);
+        if (!ret || (*ret != encoded.wire.size())) {
+            state.SkipWithError("PeekFrameLength failed");
+            break;
+        }
+        benchmark::DoNotOptimize(ret);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+    state.SetLabel(FrameTypeLabel(encoded.frame));
+}
+BENCHMARK(BM_PeekFrameLength)->ArgsProduct({{0, 64, 2047}, {0, 3}});
+
+void BM_ReadAndCopyFrame(benchmark::State& state) {
+    EncodedFrame encoded;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), state.range(1), encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    const uint8_t bit_slip_count = static_cast<uint8_t>(state.range(2));
+    const std::vector<uint8_t> slipped = BitSlip(encoded.wire, bit_slip_count);
+    std::vector<uint8_t> destination(MAX_CAN_XL_FRAME_SIZE + 1U);
+    Frame frame{};
+    for (auto _ : state) {
+        etl::byte_stream_reader reader(slipped.data(), slipped.size(), etl::endian::big);
+        auto ret = frame_reader::ReadAndCopyFrame(
+            reader, etl::span<uint8_t>(destination.data(), destination.size()), frame, bit_slip_count);
+        if (!ret) {
+            state.SkipWithError("ReadAndCopyFrame failed");
+            break;
+        }
+        benchmark::DoNotOptimize(frame);
+        benchmark::ClobberMemory();
+    }
+    SetFrameCounters(state, encoded);
+}
+BENCHMARK(BM_ReadAndCopyFrame)
+    ->ArgsProduct({kPayloadSizes, {0, kFlagIde | kFlagTtl | kFlagWa}, benchmark::CreateDenseRange(0, 7, 1)});
+
+// ReadAndCopyFrame with an acceptance filter that rejects (0) or accepts (1) the frame: a rejected frame is skipped
+// once its CAN identifier is read
+void BM_ReadAndCopyFrameFiltered(benchmark::State& state) {
+    EncodedFrame encoded;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), 0, encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    const bool accepted = state.range(1) != 0;
+    const uint8_t bit_slip_count = static_cast<uint8_t>(state.range(2));
+    const std::vector<uint8_t> slipped = BitSlip(encoded.wire, bit_slip_count);
+    frame_reader::AcceptanceFilter filter;
+    filter.AddStandardId(static_cast<uint16_t>(accepted ? encoded.frame.can_identifier : 0x7FFU));
+    std::vector<uint8_t> destination(MAX_CAN_XL_FRAME_SIZE + 1U);
+    Frame frame{};
+    for (auto _ : state) {
+        etl::byte_stream_reader reader(slipped.data(), slipped.size(), etl::endian::big);
+        auto ret = frame_reader::ReadAndCopyFrame(
+            reader, etl::span<uint8_t>(destination.data(), destination.size()), frame, bit_slip_count, filter);
+        if (ret.has_value() != accepted) {
+            state.SkipWithError("ReadAndCopyFrame failed");
+            break;
+        }
+        benchmark::DoNotOptimize(frame);
+        benchmark::ClobberMemory();
+    }
+    SetFrameCounters(state, encoded);
+}
+BENCHMARK(BM_ReadAndCopyFrameFiltered)->ArgsProduct({kPayloadSizes, {0, 1}, {0, 3}});
+
+// The same frames received into a circular DMA buffer with the wrap in the middle of the payload
+void BM_ReadAndCopyFrameWrapped(benchmark::State& state) {
+    EncodedFrame encoded;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), kFlagIde | kFlagTtl | kFlagWa, encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    const uint8_t bit_slip_count = static_cast<uint8_t>(state.range(1));
+    std::vector<uint8_t> slipped = BitSlip(encoded.wire, bit_slip_count);
+    // the ring holds exactly the received bytes, read from its middle
+    const size_t tail = slipped.size() / 2U;
+    std::vector<uint8_t> ring(slipped.size());
+    for (size_t i = 0U; i < slipped.size(); ++i) {
+        ring[(tail + i) % ring.size()] = slipped[i];
+    }
+    const frame_reader::WrappedBuffer input(etl::span<uint8_t>(ring.data() + tail, ring.size() - tail),
+                                            etl::span<uint8_t>(ring.data(), tail));
+    std::vector<uint8_t> destination(MAX_CAN_XL_FRAME_SIZE + 1U);
+    Frame frame{};
+    for (auto _ : state) {
+        auto ret = frame_reader::ReadAndCopyFrame(input, 0U, etl::span<uint8_t>(destination.data(), destination.size()),
+                                                  frame, bit_slip_count);
+        if (!ret) {
+            state.SkipWithError("ReadAndCopyFrame failed");
+            break;
+        }
+        benchmark::DoNotOptimize(frame);
+        benchmark::ClobberMemory();
+    }
+    SetFrameCounters(state, encoded);
+}
+BENCHMARK(BM_ReadAndCopyFrameWrapped)->ArgsProduct({kPayloadSizes, {0, 3}});
+
+void BM_DecrementTimeToLiveInPlace(benchmark::State& state) {
+    EncodedFrame encoded;
+    if (!BuildFrame(static_cast<size_t>(state.range(0)), kFlagTtl, encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    for (auto _ : state) {
+        encoded.frame.time_to_live = 200U;  // keep the counter away from expiring, the byte value does not matter
+        encoded.wire[PREAMBLE_SIZE + encoded.frame.GetHeaderLength() - TIME_TO_LIVE_SIZE] = 200U;
+        auto ret = frame_writer::DecrementTimeToLiveInPlace(
+            etl::span<uint8_t>(encoded.wire.data(), encoded.wire.size()), encoded.frame);
+        benchmark::DoNotOptimize(ret);
+        benchmark::ClobberMemory();
+    }
+    SetFrameCounters(state, encoded);
+}
+BENCHMARK(BM_DecrementTimeToLiveInPlace)->ArgsProduct({kPayloadSizes});
+
+// Scan a capture of back-to-back FD frames separated by idle gaps for every preamble. Clean captures idle at 0x00,
+// noisy ones are filled with random bytes, which contain plenty of preamble byte candidates.
+void BM_FindNextFramePreamble(benchmark::State& state) {
+    const bool noisy = state.range(0) != 0;
+    const uint8_t bit_slip_count = static_cast<uint8_t>(state.range(1));
+    constexpr size_t kCaptureSize = 64U * 1024U;
+    constexpr size_t kIdleGap = 32U;
+
+    EncodedFrame encoded;
+    if (!BuildFrame(MAX_FD_PAYLOAD_SIZE, kFlagTtl, encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    std::mt19937 random(1234U);
+    std::vector<uint8_t> capture;
+    capture.reserve(kCaptureSize);
+    while (capture.size() + encoded.wire.size() + kIdleGap < kCaptureSize) {
+        capture.insert(capture.end(), encoded.wire.begin(), encoded.wire.end());
+        for (size_t i = 0U; i < kIdleGap; ++i) {
+            capture.push_back(noisy ? static_cast<uint8_t>(random()) : 0U);
+        }
+    }
+    std::vector<uint8_t> slipped = BitSlip(capture, bit_slip_count);
+    const etl::span<uint8_t> buffer(slipped.data(), slipped.size());
+
+    size_t preambles_found = 0U;
+    for (auto _ : state) {
+        preambles_found = 0U;
+        frame_reader::FrameSearchResult result = frame_reader::FindNextFramePreamble(buffer, 0U);
+        while (result.valid_preamble_found) {
+            ++preambles_found;
+            result = frame_reader::FindNextFramePreamble(buffer, result.frame_start_offset + PREAMBLE_SIZE);
+        }
+        benchmark::DoNotOptimize(preambles_found);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(buffer.size()));
+    state.counters["preambles"] = static_cast<double>(preambles_found);
+    state.SetLabel(noisy ? "noisy" : "clean");
+}
+BENCHMARK(BM_FindNextFramePreamble)->ArgsProduct({{0, 1}, benchmark::CreateDenseRange(0, 7, 1)});
+
+// Extract every frame from the same captures as BM_FindNextFramePreamble with one ParseAll() call per pass
+void BM_ParseAll(benchmark::State& state) {
+    const bool noisy = state.range(0) != 0;
+    const uint8_t bit_slip_count = static_cast<uint8_t>(state.range(1));
+    constexpr size_t kCaptureSize = 64U * 1024U;
+    constexpr size_t kIdleGap = 32U;
+
+    EncodedFrame encoded;
+    if (!BuildFrame(MAX_FD_PAYLOAD_SIZE, kFlagTtl, encoded)) {
+        state.SkipWithError("WriteFrame failed");
+        return;
+    }
+    std::mt19937 random(1234U);
+    std::vector<uint8_t> capture;
+    capture.reserve(kCaptureSize);
+    while (capture.size() + encoded.wire.size() + kIdleGap < kCaptureSize) {
+        capture.insert(capture.end(), encoded.wire.begin(), encoded.wire.end());
+        for (size_t i = 0U; i < kIdleGap; ++i) {
+            capture.push_back(noisy ? static_cast<uint8_t>(random()) : 0U);
+        }
+    }
+    std::vector<uint8_t> slipped = BitSlip(capture, bit_slip_count);
+    const etl::span<uint8_t> buffer(slipped.data(), slipped.size());
+    std::vector<frame_reader::FrameDescriptor> descriptors(kCaptureSize / encoded.wire.size() + 64U);
+    std::vector<uint8_t> scratch(MAX_CAN_XL_FRAME_SIZE, 0U);
+    const etl::span<frame_reader::FrameDescriptor> descriptor_span(descriptors.data(), descriptors.size());
+    const etl::span<uint8_t> scratch_span(scratch.data(), scratch.size());
+
+    size_t valid_frames = 0U;
+    for (auto _ : state) {
+        const frame_reader::ParseAllResult result = frame_reader::ParseAll(buffer, descriptor_span, scratch_span);
+        valid_frames = 0U;
+        for (size_t i = 0U; i < result.descriptor_count; ++i) {
+            valid_frames += descriptors[i].valid ? 1U : 0U;
+        }
+        benchmark::DoNotOptimize(valid_frames);
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(buffer.size()));
+    state.counters["frames"] = static_cast<double>(valid_frames);
+    state.SetLabel(noisy ? "noisy" : "clean");
+}
+BENCHMARK(BM_ParseAll)->ArgsProduct({{0, 1}, {0, 3}});
+
+// Worst cases for the preamble search: line noise (e.g. after a cable fault) full of candidate bytes that never
+// complete a preamble, so every candidate is rejected and the search runs to the end of the capture. Each pattern is
+// repeated over the capture; the reported complexity should stay O(N) in the capture size.
+enum class NoisePattern { ComplementRejects, RareComplement, LonePreambleBytes };
+
+void BM_FindNextFramePreambleAdversarial(benchmark::State& state, const NoisePattern pattern) {
+    const size_t capture_size = static_cast<size_t>(state.range(0));
+    std::vector<uint8_t> capture(capture_size, 0x00U);
+    bool bit_slips_allowed = true;
+    for (size_t i = 0U; i < capture_size; ++i) {
+        switch (pattern) {
+            case NoisePattern::ComplementRejects:  // a complement every other byte, with the wrong bit before it
+                capture[i] = (i % 2U) ? PREAMBLE_BYTE_COMPLEMENT : 0x00U;
+                break;
+            case NoisePattern::RareComplement:  // no preamble bytes at all and the odd rejected complement
+                capture[i] = (i % 16U == 15U) ? PREAMBLE_BYTE_COMPLEMENT : 0x00U;
+                break;
+            case NoisePattern::LonePreambleBytes:  // aligned search over preamble bytes that never come in pairs
+                capture[i] = (i % 2U) ? 0x00U : PREAMBLE_BYTE;
+                bit_slips_allowed = false;
+                break;
+        }
+    }
+    const etl::span<uint8_t> buffer(capture.data(), capture.size());
+
+    for (auto _ : state) {
+        frame_reader::FrameSearchResult result = frame_reader::FindNextFramePreamble(buffer, 0U, bit_slips_allowed);
+        benchmark::DoNotOptimize(result);
+        if (result.valid_preamble_found) {
+            state.SkipWithError("noise pattern contains a preamble");
+            return;
+        }
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(capture_size));
+    state.SetComplexityN(static_cast<int64_t>(capture_size));
+}
+BENCHMARK_CAPTURE(BM_FindNextFramePreambleAdversarial, complement_rejects, NoisePattern::ComplementRejects)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_FindNextFramePreambleAdversarial, rare_complement, NoisePattern::RareComplement)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->Complexity(benchmark::oN);
+BENCHMARK_CAPTURE(BM_FindNextFramePreambleAdversarial, lone_preamble_bytes, NoisePattern::LonePreambleBytes)
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 18)
+    ->Complexity(benchmark::oN);
+
+// --- Algorithm backend ---
+
+void BM_ComputeCrc16(benchmark::State& state) {
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)), 0x5AU);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algorithms::ComputeCrc16(etl::span<const uint8_t>(data.data(), data.size())));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ComputeCrc16)->Arg(4)->Arg(8)->Arg(MAX_CAN_CC_FRAME_SIZE);
+
+void BM_ComputeCrc32(benchmark::State& state) {
+    std::vector<uint8_t> data(static_cast<size_t>(state.range(0)), 0x5AU);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(algorithms::ComputeCrc32(etl::span<const uint8_t>(data.data(), data.size())));
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+BENCHMARK(BM_ComputeCrc32)->Arg(16)->Arg(64)->Arg(512)->Arg(MAX_XL_PAYLOAD_SIZE);
+
+constexpr size_t kSecdedWords = 1024U;
+
+// Headers with a single bit error in every 16th word, so the correction path is part of the measurement
+std::vector<uint16_t> MakeSecdedWords() {
+    std::vector<uint16_t> words(kSecdedWords);
+    for (size_t i = 0U; i < kSecdedWords; ++i) {
+        words[i] = algorithms::Secded16Encode11(static_cast<uint16_t>((i * 37U) & 0x07FFU));
+        if ((i % 16U) == 15U) {
+            words[i] ^= static_cast<uint16_t>(1U << (i % 16U));
+        }
+    }
+    return words;
+}
+
+void BM_Secded16Encode11(benchmark::State& state) {
+    std::vector<uint16_t> encoded(kSecdedWords);
+    for (auto _ : state) {
+        for (size_t i = 0U; i < kSecdedWords; ++i) {
+            encoded[i] = algorithms::Secded16Encode11(static_cast<uint16_t>(i & 0x07FFU));
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kSecdedWords));
+}
+BENCHMARK(BM_Secded16Encode11);
+
+void BM_Secded16Decode11(benchmark::State& state) {
+    const std::vector<uint16_t> words = MakeSecdedWords();
+    std::vector<uint16_t> data(kSecdedWords);
+    for (auto _ : state) {
+        for (size_t i = 0U; i < kSecdedWords; ++i) {
+            data[i] = algorithms::Secded16Decode11(words[i]).data11;
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kSecdedWords));
+}
+BENCHMARK(BM_Secded16Decode11);
+
+void BM_Secded16Decode11Batch(benchmark::State& state) {
+    const std::vector<uint16_t> words = MakeSecdedWords();
+    std::vector<uint16_t> data(kSecdedWords);
+    std::vector<uint32_t> corrected(algorithms::Secded16BatchMaskWords(kSecdedWords));
+    std::vector<uint32_t> uncorrectable(algorithms::Secded16BatchMaskWords(kSecdedWords));
+    for (auto _ : state) {
+        algorithms::Secded16Decode11Batch(etl::span<const uint16_t>(words.data(), words.size()),
+                                          etl::span<uint16_t>(data.data(), data.size()),
+                                          etl::span<uint32_t>(corrected.data(), corrected.size()),
+                                          etl::span<uint32_t>(uncorrectable.data(), uncorrectable.size()));
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * kSecdedWords));
+}
+BENCHMARK(BM_Secded16Decode11Batch);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    // recorded in the context block of the JSON output so results of different backends can be told apart
+    benchmark::AddCustomContext("spiopen_frame_algorithm_backend", SPIOPEN_FRAME_BENCH_ALGORITHM_BACKEND);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
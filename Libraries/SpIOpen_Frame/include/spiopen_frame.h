@@ -26,6 +26,7 @@ class Frame final {
         unsigned int XLF : 1;  // XL Format flag
         unsigned int TTL : 1;  // Time to Live flag
         unsigned int WA : 1;   // Word Alignment flag
+        unsigned int DWA : 1;  // Double Word Alignment flag (CONFIG_SPIOPEN_FRAME_WIDE_ALIGNMENT_ENABLE)
     } Flags;
 
     /* Structure that contains the CAN-XL control fields*/
@@ -134,12 +135,23 @@ class Frame final {
         }
         size_t crc_length = format::GetCrcLengthFromPayloadLength(payload_length);
         frame_length_out = format::PREAMBLE_SIZE + GetHeaderLength() + payload_length + crc_length;
-        if (can_flags.WA && ((frame_length_out & 0x1U) != 0U)) {
-            frame_length_out += format::MAX_PADDING_SIZE;
-        }
+        frame_length_out += format::GetAlignmentPaddingLength(frame_length_out, GetAlignment());
         return true;
     }
 
+    /**
+     * @brief The multiple the frame length is padded to on the wire: 2 with the WA flag, 4 with the DWA flag, 8 with
+     * both, and 1 (no padding) with neither. The DWA flag is only used with CONFIG_SPIOPEN_FRAME_WIDE_ALIGNMENT_ENABLE.
+     * @return The alignment in bytes
+     */
+    inline size_t GetAlignment() const {
+#ifdef CONFIG_SPIOPEN_FRAME_WIDE_ALIGNMENT_ENABLE
+        return static_cast<size_t>(1U) << ((can_flags.WA ? 1U : 0U) + (can_flags.DWA ? 2U : 0U));
+#else
+        return can_flags.WA ? 2U : 1U;
+#endif
+    }
+
     /**
      * @brief Clears all frame fields to their default zero/empty state.
      */
@@ -0,0 +1,98 @@
+/*
+SpIOpen Frame Acceptance Filter : CAN identifier filter the reader consults before it reads a frame's payload.
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace spiopen::frame_reader {
+
+/**
+ * @brief Accepts or rejects frames by CAN identifier, so a node on a shared bus only spends time on the frames it
+ * wants.
+ *
+ * A frame is accepted if its identifier is in the 11-bit ID bitmap (standard IDs) or the 29-bit ID hash set (extended
+ * IDs), or if it matches one of the mask/code pairs ((id & mask) == (code & mask)) for its ID type. The bitmap and
+ * hash lookups are constant time; the mask/code pairs are checked in turn, so they should be kept for ranges.
+ *
+ * A default constructed filter accepts nothing. ReadFrame() and ReadAndCopyFrame() take a filter and skip the rest of
+ * a rejected frame, without reading its payload or CRC, as soon as they have its CAN identifier.
+ */
+class AcceptanceFilter {
+   public:
+    static constexpr size_t MAX_MASK_FILTERS = 8U;
+    static constexpr size_t MAX_EXTENDED_IDS = 32U;
+
+    AcceptanceFilter() { Clear(); }
+
+    /**
+     * @brief Remove every ID and mask/code pair, so nothing is accepted
+     */
+    void Clear();
+
+    /**
+     * @brief Accept an 11-bit CAN identifier
+     * @param can_identifier The identifier; bits above the 11th are ignored
+     */
+    void AddStandardId(uint16_t can_identifier) {
+        const uint16_t id = can_identifier & STANDARD_ID_MASK;
+        standard_ids_[id >> 5U] |= static_cast<uint32_t>(1U) << (id & 0x1FU);
+    }
+
+    /**
+     * @brief Accept a 29-bit CAN identifier
+     * @param can_identifier The identifier; bits above the 29th are ignored
+     * @return false if MAX_EXTENDED_IDS identifiers are already accepted
+     */
+    bool AddExtendedId(uint32_t can_identifier);
+
+    /**
+     * @brief Accept every identifier of one type that matches code in the bits set in mask, e.g. mask 0x780 and code
+     * 0x180 for standard IDs 0x180 to 0x1FF
+     * @param code The identifier bits to match
+     * @param mask The identifier bits that must match; 0 accepts every identifier of the type
+     * @param extended True to match 29-bit identifiers, false for 11-bit
+     * @return false if MAX_MASK_FILTERS pairs are already set
+     */
+    bool AddMask(uint32_t code, uint32_t mask, bool extended);
+
+    /**
+     * @brief Check an identifier against the filter
+     * @param can_identifier The 11 or 29 bit CAN identifier
+     * @param extended True for a 29-bit identifier (the frame's IDE flag)
+     * @return true if the frame should be read
+     */
+    bool Accepts(uint32_t can_identifier, bool extended) const;
+
+   private:
+    static constexpr uint16_t STANDARD_ID_MASK = 0x7FFU;
+    static constexpr uint32_t EXTENDED_ID_MASK = 0x1FFFFFFFU;
+    static constexpr uint32_t EMPTY_SLOT = 0xFFFFFFFFU;  // not a 29-bit identifier
+    static constexpr size_t EXTENDED_ID_SLOT_BITS = 6U;  // twice MAX_EXTENDED_IDS slots, so probes stay short
+    static constexpr size_t EXTENDED_ID_SLOTS = static_cast<size_t>(1U) << EXTENDED_ID_SLOT_BITS;
+    static_assert(EXTENDED_ID_SLOTS >= 2U * MAX_EXTENDED_IDS, "the extended ID table must stay at most half full");
+
+    struct MaskFilter {
+        uint32_t code;
+        uint32_t mask;
+        bool extended;
+    };
+
+    static size_t GetExtendedIdSlot(uint32_t can_identifier) {
+        // Fibonacci hashing: the top bits of the product depend on every bit of the identifier
+        return static_cast<size_t>((can_identifier * 0x9E3779B1U) >> (32U - EXTENDED_ID_SLOT_BITS));
+    }
+
+    std::array<uint32_t, (STANDARD_ID_MASK + 1U) / 32U> standard_ids_;  // one bit per 11-bit identifier
+    std::array<uint32_t, EXTENDED_ID_SLOTS> extended_ids_;             // open addressing, linear probing
+    size_t extended_id_count_;
+    std::array<MaskFilter, MAX_MASK_FILTERS> masks_;
+    size_t mask_count_;
+};
+
+}  // namespace spiopen::frame_reader
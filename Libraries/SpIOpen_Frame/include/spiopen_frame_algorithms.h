@@ -27,8 +27,41 @@ struct Secded16DecodeResult {
 uint16_t ComputeCrc16(const etl::span<const uint8_t>& data);
 uint32_t ComputeCrc32(const etl::span<const uint8_t>& data);
 
+// Incremental CRC for data that is produced or received in pieces (copy loops, DMA half-buffers). Start from
+// CrcXXInit(), fold each piece in wire order with CrcXXUpdate(), then read the checksum with CrcXXFinalize(). Any split
+// of the data (including empty pieces) gives the same result as ComputeCrcXX() over the whole region.
+struct Crc16Context {
+    uint16_t remainder;
+};
+struct Crc32Context {
+    uint32_t remainder;
+};
+
+static constexpr uint16_t CRC16_INITIAL_VALUE = 0xFFFFU;      // CRC-16-CCITT: no reflection, no final xor
+static constexpr uint32_t CRC32_INITIAL_VALUE = 0xFFFFFFFFU;  // CRC-32/MPEG-2: no reflection, no final xor
+static constexpr uint16_t CRC16_POLYNOMIAL = 0x1021U;         // CRC-16-CCITT, without the x^16 term
+static constexpr uint32_t CRC32_POLYNOMIAL = 0x04C11DB7U;     // CRC-32/MPEG-2, without the x^32 term
+
+inline Crc16Context Crc16Init() { return Crc16Context{CRC16_INITIAL_VALUE}; }
+inline Crc32Context Crc32Init() { return Crc32Context{CRC32_INITIAL_VALUE}; }
+void Crc16Update(Crc16Context& context, const etl::span<const uint8_t>& data);
+void Crc32Update(Crc32Context& context, const etl::span<const uint8_t>& data);
+inline uint16_t Crc16Finalize(const Crc16Context& context) { return context.remainder; }
+inline uint32_t Crc32Finalize(const Crc32Context& context) { return context.remainder; }
+
 // The goal with the SECDED encoding should be to make the "typical" path (no errors) as fast as possible.
 uint16_t Secded16Encode11(uint16_t raw11);
 Secded16DecodeResult Secded16Decode11(uint16_t encoded16);
 
+// Batch SECDED over arrays of words, e.g. the format headers of many preamble candidates or every header of a TX cycle.
+// Bit (i % 32) of mask word (i / 32) reports word i, so each mask needs Secded16BatchMaskWords(count) entries. Returns
+// false without writing anything if an output is too short. These are not part of the backend: they are implemented
+// once (spiopen_frame_algorithms_batch.cpp) with SSE2/AVX2/NEON kernels, and fall back to the single-word functions
+// above for words with errors and on targets without SIMD.
+inline constexpr size_t Secded16BatchMaskWords(const size_t word_count) { return (word_count + 31U) / 32U; }
+bool Secded16Encode11Batch(const etl::span<const uint16_t>& raw11, const etl::span<uint16_t>& encoded16_out);
+bool Secded16Decode11Batch(const etl::span<const uint16_t>& encoded16, const etl::span<uint16_t>& data11_out,
+                           const etl::span<uint32_t>& corrected_mask_out,
+                           const etl::span<uint32_t>& uncorrectable_mask_out);
+
 }  // namespace spiopen::algorithms
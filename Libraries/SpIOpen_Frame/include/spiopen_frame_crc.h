@@ -0,0 +1,160 @@
+/*
+SpIOpen Frame CRC : Incremental CRC over the protected region of a SpIOpen frame.
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "etl/span.h"
+#include "spiopen_frame_algorithms.h"
+#include "spiopen_frame_format.h"
+
+namespace spiopen {
+
+namespace crc_impl {
+
+// Arithmetic on polynomials modulo a CRC polynomial (non-reflected, Polynomial given without its x^width term)
+template <typename TCrc, TCrc Polynomial>
+struct CrcPolynomialMath {
+    static constexpr TCrc top_bit = static_cast<TCrc>(static_cast<TCrc>(1U) << ((sizeof(TCrc) * 8U) - 1U));
+
+    static constexpr TCrc MultiplyByX(const TCrc value) {
+        return static_cast<TCrc>((value & top_bit) != 0U ? static_cast<TCrc>(value << 1U) ^ Polynomial
+                                                         : static_cast<TCrc>(value << 1U));
+    }
+
+    // a * b mod P, for a and b already reduced
+    static constexpr TCrc Multiply(const TCrc a, const TCrc b) {
+        TCrc product = 0U;
+        for (TCrc bit = top_bit; bit != 0U; bit = static_cast<TCrc>(bit >> 1U)) {
+            product = MultiplyByX(product);
+            if ((b & bit) != 0U) {
+                product = static_cast<TCrc>(product ^ a);
+            }
+        }
+        return product;
+    }
+
+    static constexpr TCrc XPower(const size_t power) {
+        TCrc value = 1U;
+        for (size_t i = 0U; i < power; ++i) {
+            value = MultiplyByX(value);
+        }
+        return value;
+    }
+};
+
+// x^(8 * distance + width) mod P for every distance in a frame, split into a table for the last 64 bytes and a table
+// for multiples of 64 bytes so the whole frame is covered by 97 entries.
+static constexpr size_t crc_shift_near_bytes = 64U;
+static constexpr size_t crc_shift_far_entries = (format::MAX_CAN_XL_FRAME_SIZE / crc_shift_near_bytes) + 1U;
+
+template <typename TCrc, TCrc Polynomial>
+struct CrcShiftTables {
+    std::array<TCrc, crc_shift_near_bytes> near;  // x^(8 * n + width), n < 64
+    std::array<TCrc, crc_shift_far_entries> far;  // x^(8 * 64 * m)
+};
+
+template <typename TCrc, TCrc Polynomial>
+constexpr CrcShiftTables<TCrc, Polynomial> MakeCrcShiftTables() {
+    using Math = CrcPolynomialMath<TCrc, Polynomial>;
+    CrcShiftTables<TCrc, Polynomial> tables{};
+    const TCrc x8 = Math::XPower(8U);
+    tables.near[0] = Math::XPower(sizeof(TCrc) * 8U);
+    for (size_t n = 1U; n < crc_shift_near_bytes; ++n) {
+        tables.near[n] = Math::Multiply(tables.near[n - 1U], x8);
+    }
+    const TCrc x512 = Math::XPower(crc_shift_near_bytes * 8U);
+    tables.far[0] = 1U;
+    for (size_t m = 1U; m < crc_shift_far_entries; ++m) {
+        tables.far[m] = Math::Multiply(tables.far[m - 1U], x512);
+    }
+    return tables;
+}
+
+template <typename TCrc, TCrc Polynomial>
+inline constexpr CrcShiftTables<TCrc, Polynomial> crc_shift_tables = MakeCrcShiftTables<TCrc, Polynomial>();
+
+template <typename TCrc, TCrc Polynomial>
+inline TCrc GetByteChangeDelta(const uint8_t byte_delta, size_t bytes_after) {
+    using Math = CrcPolynomialMath<TCrc, Polynomial>;
+    const CrcShiftTables<TCrc, Polynomial>& tables = crc_shift_tables<TCrc, Polynomial>;
+    TCrc delta = Math::Multiply(byte_delta, tables.near[bytes_after % crc_shift_near_bytes]);
+    for (bytes_after /= crc_shift_near_bytes; bytes_after >= crc_shift_far_entries;
+         bytes_after -= crc_shift_far_entries - 1U) {  // only reached for distances longer than any frame
+        delta = Math::Multiply(delta, tables.far[crc_shift_far_entries - 1U]);
+    }
+    return Math::Multiply(delta, tables.far[bytes_after]);
+}
+
+}  // namespace crc_impl
+
+/**
+ * @brief Incremental CRC over a frame, from the format header up to (not including) the CRC field.
+ *
+ * The CRC width follows from the on-wire payload section length, so the accumulator is created once the header has
+ * been parsed (or, when writing, once the layout is known). Bytes are folded in wire order with Add(), in as many
+ * pieces as convenient, so copy loops can checksum data while it is still in cache.
+ */
+class FrameCrc final {
+   public:
+    explicit FrameCrc(const size_t payload_section_length)
+        : is_long_(format::GetCrcLengthFromPayloadLength(payload_section_length) == format::LONG_CRC_SIZE),
+          crc16_(algorithms::Crc16Init()),
+          crc32_(algorithms::Crc32Init()) {}
+
+    /**
+     * @brief Fold the next bytes of the protected region into the CRC.
+     */
+    inline void Add(const etl::span<const uint8_t>& data) {
+        if (is_long_) {
+            algorithms::Crc32Update(crc32_, data);
+        } else {
+            algorithms::Crc16Update(crc16_, data);
+        }
+    }
+
+    /**
+     * @brief Size of the CRC field on the wire in bytes
+     */
+    inline size_t GetSize() const { return is_long_ ? format::LONG_CRC_SIZE : format::SHORT_CRC_SIZE; }
+
+    /**
+     * @brief The CRC over everything added so far, widened to 32 bits for CRC16 frames
+     */
+    inline uint32_t GetValue() const {
+        return is_long_ ? algorithms::Crc32Finalize(crc32_) : algorithms::Crc16Finalize(crc16_);
+    }
+
+    inline bool IsLong() const { return is_long_; }
+
+    /**
+     * @brief The change of the CRC when one byte of the protected region is changed after the CRC was computed.
+     *
+     * The frame CRCs are not reflected and have no final xor, so changing one byte by byte_delta (old XOR new) changes
+     * the CRC by byte_delta * x^(8 * bytes_after + width) mod P whatever the rest of the frame holds. XOR the result
+     * into the stored CRC to patch it in constant time, without touching the payload.
+     * @param is_long True for the CRC32 of long frames, false for CRC16 (see IsLong())
+     * @param byte_delta The XOR of the old and new value of the changed byte
+     * @param bytes_after Number of protected bytes between the changed byte and the CRC field
+     * @return The value to XOR into the CRC, widened to 32 bits for CRC16 frames
+     */
+    static inline uint32_t GetByteChangeDelta(const bool is_long, const uint8_t byte_delta, const size_t bytes_after) {
+        if (is_long) {
+            return crc_impl::GetByteChangeDelta<uint32_t, algorithms::CRC32_POLYNOMIAL>(byte_delta, bytes_after);
+        }
+        return crc_impl::GetByteChangeDelta<uint16_t, algorithms::CRC16_POLYNOMIAL>(byte_delta, bytes_after);
+    }
+
+   private:
+    bool is_long_;
+    algorithms::Crc16Context crc16_;
+    algorithms::Crc32Context crc32_;
+};
+
+}  // namespace spiopen
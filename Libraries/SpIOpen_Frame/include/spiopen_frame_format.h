@@ -30,8 +30,13 @@ static constexpr size_t MAX_FD_PAYLOAD_SIZE = 64;  // Maximum payload size in by
 static constexpr size_t MAX_XL_PAYLOAD_SIZE = 2048;  // Maximum payload size in bytes for CAN-XL frames
 static constexpr size_t SHORT_CRC_SIZE = 2;          // Size of the CRC16 checksum in bytes (Payloads <= 8 Bytes long)
 static constexpr size_t LONG_CRC_SIZE = 4;           // Size of the CRC32 checksum in bytes (Payloads > 8 Bytes long)
+#ifdef CONFIG_SPIOPEN_FRAME_WIDE_ALIGNMENT_ENABLE
+static constexpr size_t MAX_FRAME_ALIGNMENT = 8;  // Largest multiple a frame is padded to (WA and DWA flags set)
+#else
+static constexpr size_t MAX_FRAME_ALIGNMENT = 2;  // Largest multiple a frame is padded to (WA flag set)
+#endif
 static constexpr size_t MAX_PADDING_SIZE =
-    1;  // Maximum size of the padding byte in bytes (Only used if WA flag is set)
+    MAX_FRAME_ALIGNMENT - 1;  // Maximum size of the padding in bytes (Only used if the WA or DWA flag is set)
 
 /* Macros that define the byte masks for the various bit-stuffed flags and sub-integers of the header */
 static constexpr uint8_t HEADER_DLC_MASK = 0x0F;  // Mask for the DLC field in the low byte of the format header
@@ -41,6 +46,8 @@ static constexpr uint8_t HEADER_XLF_MASK = 0x40;  // Mask for the XLF field in t
 static constexpr uint8_t HEADER_TTL_MASK = 0x80;  // Mask for the TTL field in the low byte of the format header
 static constexpr uint8_t HEADER_WA_MASK =
     0x01;  // Mask for the word alignment field in the high byte of the format header
+static constexpr uint8_t HEADER_DWA_MASK =
+    0x02;  // Mask for the double word alignment field in the high byte of the format header
 static constexpr uint8_t CID_RTR_MASK = 0x80;  // Mask for the RTR/RRS field in the highest byte of the CAN identifier
 static constexpr uint8_t CID_BRS_MASK = 0x40;  // Mask for the BRS field in the highest byte of the CAN identifier
 static constexpr uint8_t CID_ESI_MASK = 0x20;  // Mask for the ESI field in the highest byte of the CAN identifier
@@ -64,6 +71,35 @@ static constexpr size_t MAX_CAN_FD_FRAME_SIZE =
 static constexpr size_t MAX_CAN_XL_FRAME_SIZE =
     (MAX_CAN_XL_HEADER_SIZE + MAX_XL_PAYLOAD_SIZE + LONG_CRC_SIZE + MAX_PADDING_SIZE);
 
+// Bytes from the start of a frame that always determine its length: the format header, plus the XL data length for
+// XL frames. The shortest frame is longer than this, so it can always be read before the length is known.
+static constexpr size_t LENGTH_PREFIX_SIZE = (PREAMBLE_SIZE + FORMAT_HEADER_SIZE + XL_DATA_LENGTH_SIZE);
+
+/* SECDED(16,11) code of the format header and XL data length: the data bits are in the low bits of the encoded word,
+ * Hamming parity bits 0-3 in bits 11-14 and the overall parity in bit 15 */
+static constexpr uint16_t SECDED16_NUM_DATA_BITS = 11U;      // Number of data bits in an encoded word
+static constexpr uint16_t SECDED16_NUM_PARITY_BITS = 5U;     // Number of parity bits in an encoded word
+static constexpr uint16_t SECDED16_DATA_BIT_MASK = 0x07FFU;  // Mask for the data bits of an encoded word
+static constexpr uint16_t SECDED16_PARITY_DATA_MASKS[SECDED16_NUM_PARITY_BITS] = {
+    0b0000'0101'0101'1011,   // hamming parity bit 0, encoding bits [0,1,3,4,6,8,10]
+    0b0000'0110'0110'1101,   // hamming parity bit 1, encoding bits [0,2,3,5,6,9,10]
+    0b0000'0111'1000'1110,   // hamming parity bit 2, encoding bits [1,2,3,7,8,9,10]
+    0b0000'0111'1111'0000,   // hamming parity bit 3, encoding bits [4,5,6,7,8,9,10]
+    0b0111'1111'1111'1111};  // overall parity encoding all data bits and parity bits
+
+// SECDED(16,11) systematic encoding, usable in constant expressions. The algorithm backends compute the same code at
+// run time with Secded16Encode11(), from this or from a table built with it.
+static constexpr uint16_t Secded16Encode11Bitwise(const uint16_t raw11) noexcept {
+    uint16_t code = raw11 & SECDED16_DATA_BIT_MASK;
+    for (uint16_t parity_bit_index = 0U; parity_bit_index < SECDED16_NUM_PARITY_BITS; ++parity_bit_index) {
+        if (__builtin_popcount(code & SECDED16_PARITY_DATA_MASKS[parity_bit_index]) & 1U) {
+            // set the parity bit so the group has even parity
+            code = static_cast<uint16_t>(code | (1U << (SECDED16_NUM_DATA_BITS + parity_bit_index)));
+        }
+    }
+    return code;
+}
+
 // Convert a 4-bit DLC nibble to the payload length in bytes
 // Only valid for CAN-CC and CAN-FD frames
 static inline size_t GetPayloadLengthFromDlc(const uint8_t dlc_nibble) {
@@ -88,7 +124,12 @@ static inline bool TryGetDlcFromPayloadLength(const size_t payload_length, uint8
     return false;
 }
 
-static inline size_t GetCrcLengthFromPayloadLength(const size_t payload_length) noexcept {
+static constexpr size_t GetCrcLengthFromPayloadLength(const size_t payload_length) noexcept {
     return (payload_length <= MAX_CC_PAYLOAD_SIZE) ? SHORT_CRC_SIZE : LONG_CRC_SIZE;
 }
+
+// Number of padding bytes that make a frame of unpadded_length bytes a multiple of alignment (1, 2, 4 or 8)
+static constexpr size_t GetAlignmentPaddingLength(const size_t unpadded_length, const size_t alignment) noexcept {
+    return (alignment - (unpadded_length & (alignment - 1U))) & (alignment - 1U);
+}
 }  // namespace spiopen::format
\ No newline at end of file
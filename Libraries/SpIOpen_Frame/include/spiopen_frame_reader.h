@@ -13,6 +13,8 @@ SPDX-License-Identifier: Apache-2.0
 #include "etl/expected.h"
 #include "etl/span.h"
 #include "spiopen_frame.h"
+#include "spiopen_frame_acceptance_filter.h"
+#include "spiopen_frame_crc.h"
 #include "spiopen_frame_format.h"
 
 namespace spiopen::frame_reader {
@@ -32,6 +34,8 @@ enum class FrameParseError : uint8_t {
     InvalidBitSlipCount,              // Bit slip count is invalid (must be between 0 and 7)
     InvalidPayloadLength,             // Payload length is invalid for the frame type
     InvalidFrameLength,               // Frame length could not be determined from the parsed header
+    FrameFiltered,                    // CAN identifier rejected by the acceptance filter; the frame was skipped unread
+    WideAlignmentNotSupported,        // DWA flag set but 4 and 8 byte alignment are not supported by the frame pool
 };
 
 /** Result of a frame read/parse operation. */
@@ -58,6 +62,37 @@ struct FrameSearchResult {
     bool valid_preamble_found;  // True if a valid preamble was found
 };
 
+/**
+ * @brief Received bytes that may wrap around the end of a circular (e.g. DMA) buffer: the oldest bytes in first, then
+ * the bytes that wrapped to the start of the buffer in second. Offsets count from the start of first.
+ */
+struct WrappedBuffer {
+    etl::span<uint8_t> first;
+    etl::span<uint8_t> second;  // empty if the bytes did not wrap
+
+    WrappedBuffer() = default;
+    WrappedBuffer(etl::span<uint8_t> first_part, etl::span<uint8_t> second_part)
+        : first(first_part), second(second_part) {}
+
+    /**
+     * @brief The bytes of a ring buffer from the read index (tail, oldest byte) up to the write index (head)
+     * @param ring The whole ring buffer
+     * @param tail Index of the oldest unread byte
+     * @param head Index the next byte will be written to. Equal to tail means empty.
+     */
+    static WrappedBuffer FromRing(etl::span<uint8_t> ring, size_t tail, size_t head) {
+        if (head >= tail) {
+            return WrappedBuffer(ring.subspan(tail, head - tail), etl::span<uint8_t>());
+        }
+        return WrappedBuffer(ring.subspan(tail), ring.first(head));
+    }
+
+    size_t size() const { return first.size() + second.size(); }
+    uint8_t operator[](size_t index) const {
+        return (index < first.size()) ? first[index] : second[index - first.size()];
+    }
+};
+
 /**
  * @brief Read a SpIOpen frame from a byte stream. On success, the frame's payload span points into the stream's
  * buffer.
@@ -67,6 +102,20 @@ struct FrameSearchResult {
  */
 etl::expected<FrameReadResult, FrameParseError> ReadFrame(etl::byte_stream_reader& stream, Frame& out_frame);
 
+/**
+ * @brief Read a SpIOpen frame from a byte stream if the acceptance filter accepts its CAN identifier. A rejected frame
+ * is skipped as soon as its identifier is read, by the length in its header, without reading its payload or CRC.
+ * @param stream Byte stream reader positioned at the start of the frame (preamble). Uses big-endian. Left after the
+ * frame when it is read or skipped.
+ * @param out_frame The Frame object to store the read frame. For a rejected frame only the header fields up to the
+ * CAN identifier are set.
+ * @param filter The acceptance filter
+ * @return On success, FrameReadResult with dlc_corrected flag; FrameFiltered for a rejected frame; otherwise the parse
+ * error. A rejected frame that is not all in the stream gives BufferTooShortForPayload.
+ */
+etl::expected<FrameReadResult, FrameParseError> ReadFrame(etl::byte_stream_reader& stream, Frame& out_frame,
+                                                          const AcceptanceFilter& filter);
+
 /**
  * @brief Read a SpIOpen frame from an input byte stream, copy it with optional bit-slip correction into a
  * destination buffer, and parse the result into the frame.
@@ -80,6 +129,50 @@ etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrame(etl::byte_strea
                                                                  etl::span<uint8_t> destination_buffer,
                                                                  Frame& out_frame, uint8_t bit_slip_count);
 
+/**
+ * @brief ReadAndCopyFrame() with an acceptance filter. A frame whose CAN identifier the filter rejects is skipped in
+ * the input stream as soon as its identifier is read, without copying or CRC checking its payload.
+ * @param input_stream Byte stream reader positioned at the start of the frame (preamble). Uses big-endian.
+ * @param destination_buffer Span of the buffer to receive the copied frame bytes (only the header of a rejected frame)
+ * @param out_frame The Frame object to store the read frame (payload will point into destination_buffer)
+ * @param bit_slip_count Number of bit slips to correct for (0 to 7; positive for extra bits received)
+ * @param filter The acceptance filter
+ * @return As ReadFrame() with a filter
+ */
+etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrame(etl::byte_stream_reader& input_stream,
+                                                                 etl::span<uint8_t> destination_buffer,
+                                                                 Frame& out_frame, uint8_t bit_slip_count,
+                                                                 const AcceptanceFilter& filter);
+
+/**
+ * @brief Read a SpIOpen frame from received bytes that may wrap around the end of a ring buffer, copy it with optional
+ * bit-slip correction into a destination buffer, and parse the result into the frame. A frame that does not straddle
+ * the wrap is handled as ReadAndCopyFrame() on that part; one that does is realigned straight from both parts, with no
+ * copy to make it contiguous first.
+ * @param input The received bytes
+ * @param offset Offset of the first byte of the frame (preamble) in input
+ * @param destination_buffer Span of the buffer to receive the copied frame bytes
+ * @param out_frame Pointer to the Frame object to store the read frame (payload will point into destination_buffer)
+ * @param bit_slip_count Number of bit slips to correct for (0 to 7; positive for extra bits received)
+ * @return On success, FrameReadResult with dlc_corrected flag; on failure, the parse error
+ */
+etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrame(const WrappedBuffer& input, size_t offset,
+                                                                 etl::span<uint8_t> destination_buffer,
+                                                                 Frame& out_frame, uint8_t bit_slip_count);
+
+/**
+ * @brief Work out the on-wire length of a frame from the first bytes received, e.g. to program the DMA transfer for the
+ * rest of it. Only the format header (and the XL data length of XL frames) is decoded.
+ * @param prefix The first bytes of the frame, from the preamble. format::LENGTH_PREFIX_SIZE bytes (one more if bit
+ * slipped) always suffice; fewer do for non-XL frames.
+ * @param bit_slip_count Number of bit slips to correct for (0 to 7; positive for extra bits received)
+ * @return On success, the frame length as ReadFrame() consumes it, from preamble to CRC including padding (a slipped
+ * frame spans one more byte on the wire); on failure, the parse error. BufferTooShortToDetermineLength means more of
+ * the prefix is needed.
+ */
+etl::expected<size_t, FrameParseError> PeekFrameLength(const etl::span<const uint8_t>& prefix,
+                                                       uint8_t bit_slip_count = 0U);
+
 /**
  * @brief Search for a SpIOpen frame preamble in a buffer.
  * @param buffer Span of the byte array to search for the preamble in
@@ -90,11 +183,114 @@ etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrame(etl::byte_strea
 FrameSearchResult FindNextFramePreamble(const etl::span<uint8_t>& buffer, size_t offset = 0,
                                         bool bit_slips_allowed = true);
 
+/**
+ * @brief Search for a SpIOpen frame preamble in received bytes that may wrap around the end of a ring buffer, including
+ * preambles that straddle the wrap.
+ * @param buffer The received bytes
+ * @param offset Byte offset into the buffer at which to start searching (default 0)
+ * @param bit_slips_allowed If true, allow bit-slip correction and search for complement preamble (default true)
+ * @return FrameSearchResult as FindNextFramePreamble(), with frame_start_offset counted from the start of buffer.first
+ */
+FrameSearchResult FindNextFramePreamble(const WrappedBuffer& buffer, size_t offset = 0, bool bit_slips_allowed = true);
+
+/**
+ * @brief Bit-slip tolerant preamble detector for bytes that arrive one at a time (e.g. from an SPI RX interrupt or a
+ * DMA half-buffer), so a receiver can resynchronize without first collecting a buffer to search.
+ *
+ * It keeps a 3-byte window of the stream and finds the same preambles, with the same bit slip counts, as
+ * FindNextFramePreamble does over the same bytes. Offsets are counted in bytes pushed since construction or Reset().
+ */
+class PreambleDetector {
+   public:
+    PreambleDetector() { Reset(); }
+
+    /**
+     * @brief Forget the stream history, e.g. after an idle reset of the receiver
+     */
+    void Reset() {
+        window_ = 0U;
+        bytes_pushed_ = 0U;
+        slips_ = 0U;
+    }
+
+    /**
+     * @brief Feed the next received byte
+     * @param byte The received byte
+     * @return FrameSearchResult with valid_preamble_found set once the byte completes a preamble. frame_start_offset is
+     * then the stream offset of the byte the frame starts in (the byte pushed one or two calls earlier) and
+     * bit_slip_count the slip to hand to ReadAndCopyFrame from there.
+     */
+    FrameSearchResult Push(uint8_t byte);
+
+    /**
+     * @brief Get the number of bytes pushed since construction or the last Reset()
+     */
+    size_t GetBytesPushed() const { return bytes_pushed_; }
+
+    /**
+     * @brief Get every bit slip the preamble found by the last Push() fits at (bit n set for slip n). The byte before
+     * an aligned preamble may end in preamble bits, so a preamble can fit at more than one slip; Push() reports the
+     * earliest, and a receiver that fails to read the frame there should try the others.
+     */
+    uint8_t GetPreambleSlips() const { return slips_; }
+
+   private:
+    uint32_t window_;  // the last three bytes pushed, most recent in the low byte
+    size_t bytes_pushed_;
+    uint8_t slips_;  // slips the last preamble found fits at, or 0
+};
+
+/** Summary of one frame found by ParseAll(). */
+struct FrameDescriptor {
+    size_t offset;            // Offset of the first byte of the frame (full or partial preamble) from the start of the
+                              // buffer
+    size_t length;            // Length of the frame once realigned, or 0 if the header could not be parsed
+    uint32_t can_identifier;  // CAN identifier, or 0 if the header could not be parsed
+    uint8_t bit_slip_count;   // Number of bit slips the frame was received with (0 to 7)
+    bool valid;               // True if the frame passed all checks
+    bool dlc_corrected;       // True if a header length field was corrected (valid frames only)
+    FrameParseError error;    // Reason the frame was rejected, only meaningful if valid is false
+};
+
+/** Result of a ParseAll() call. */
+struct ParseAllResult {
+    size_t descriptor_count;  // Number of descriptors written
+    size_t resume_offset;     // Offset to continue from with more data: the start of a frame cut off by the end of the
+                              // buffer, the next frame when the descriptors ran out, or the last bytes that may hold
+                              // the start of a preamble (the buffer size at the end of the data)
+};
+
+/**
+ * @brief Find and check every frame in a buffer, e.g. a capture of an SPI line.
+ *
+ * Walks the buffer once with FindNextFramePreamble() and reads each frame in place (ReadFrame()) or, when bit slipped,
+ * through the scratch buffer (ReadAndCopyFrame()). A preamble that matches at more than one slip is read at each until
+ * one passes. Frames that fail their header (SECDED) or CRC checks are reported with their error, once, and the search
+ * resynchronizes on the byte after the failed preamble. The search continues after the end of every valid frame.
+ *
+ * A frame that runs past the end of the buffer stops the search, so that the call can be repeated from resume_offset
+ * once more data has arrived; the frames after it are only found then. On the last (or only) buffer of a capture set
+ * end_of_data instead: cut-off frames are then reported as failed and the search continues, so a false preamble in
+ * the idle bytes whose length field points past the end of the buffer does not hide the frames after it.
+ * @param buffer Span of the byte array to parse
+ * @param descriptors Array that receives one descriptor per frame found, valid or not, in buffer order
+ * @param scratch_buffer Buffer that bit-slipped frames are realigned into to check them (sized for the largest frame
+ * expected). Its contents are undefined afterwards.
+ * @param bit_slips_allowed If true, also find bit-slipped frames (default true)
+ * @param end_of_data If true, no more data follows the buffer (default false)
+ * @return ParseAllResult with the number of descriptors written and the offset to resume from
+ */
+ParseAllResult ParseAll(const etl::span<uint8_t>& buffer, const etl::span<FrameDescriptor>& descriptors,
+                        const etl::span<uint8_t>& scratch_buffer, bool bit_slips_allowed = true,
+                        bool end_of_data = false);
+
 /** Helper functions; exposed for testing only. */
 namespace impl {
 etl::expected<void, FrameParseError> ParseFormatHeader(const uint8_t high, const uint8_t low, Frame& frame,
                                                        bool& dlc_corrected, size_t& payload_len_out);
 etl::expected<void, FrameParseError> ValidatePreamble(etl::byte_stream_reader& stream);
+etl::expected<void, FrameParseError> CheckFrameTypeEnabled(const Frame& frame);
+size_t GetWireFrameLength(const Frame& header, size_t payload_len);
 etl::expected<void, FrameParseError> ReadFormatHeader(etl::byte_stream_reader& stream, Frame& out_frame,
                                                       bool& dlc_corrected, size_t& payload_len_out);
 etl::expected<void, FrameParseError> ReadXlPayloadLength(etl::byte_stream_reader& stream, Frame& out_frame,
@@ -104,10 +300,19 @@ etl::expected<void, FrameParseError> ReadCanID(etl::byte_stream_reader& stream,
 etl::expected<void, FrameParseError> ReadTTL(etl::byte_stream_reader& stream, Frame& out_frame);
 etl::expected<void, FrameParseError> ValidateCRC(etl::byte_stream_reader& stream, const Frame& frame,
                                                  const etl::span<const uint8_t>& crc_region);
+etl::expected<void, FrameParseError> ValidateCRC(etl::byte_stream_reader& stream, const FrameCrc& computed_crc);
+void RealignBitSlipped(const uint8_t* source, uint8_t* dest, size_t bytes_to_copy, uint8_t bit_slip_count);
 bool CopyFromBitSlippedBuffer(etl::byte_stream_reader& source, etl::byte_stream_writer& dest, size_t bytes_to_copy,
                               uint8_t bit_slip_count);
+bool CopyFromBitSlippedBuffer(etl::byte_stream_reader& source, etl::byte_stream_writer& dest, size_t bytes_to_copy,
+                              uint8_t bit_slip_count, FrameCrc& crc);
+// Single-pass scans for the first preamble byte (or complement) and the first aligned 2-byte preamble at or after
+// offset, vectorized with SSE2/AVX2/NEON. Return buffer.size() if there is none.
+size_t ScanForPreambleByte(const etl::span<const uint8_t>& buffer, size_t offset, bool include_complement);
+size_t ScanForPreambleWord(const etl::span<const uint8_t>& buffer, size_t offset);
 etl::expected<size_t, FrameParseError> FindNextPreambleByte(const etl::span<uint8_t>& buffer, size_t offset = 0,
                                                             bool bit_slips_allowed = true);
+uint8_t MatchPreambleSlips(uint8_t previous_byte, uint8_t candidate_byte, uint8_t next_byte, bool has_previous_byte);
 etl::expected<uint8_t, FrameParseError> CountBitOffsetIntoPreviousByte(const etl::span<uint8_t>& buffer,
                                                                        size_t preamble_index = 0);
 }  // namespace impl
@@ -0,0 +1,233 @@
+/*
+SpIOpen Frame Shape : Reader and writer entry points specialized at compile time for one fixed frame layout.
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "etl/byte_stream.h"
+#include "etl/expected.h"
+#include "etl/span.h"
+#include "spiopen_frame.h"
+#include "spiopen_frame_algorithms.h"
+#include "spiopen_frame_format.h"
+#include "spiopen_frame_reader.h"
+#include "spiopen_frame_statistics.h"
+#include "spiopen_frame_writer.h"
+
+namespace spiopen {
+
+namespace shape_impl {
+
+// The DLC of a payload length, or 16 if no DLC encodes the length exactly
+constexpr size_t GetExactDlc(const size_t payload_size) {
+    for (size_t dlc = 0U; dlc < 16U; ++dlc) {
+        if (format::CAN_FD_PAYLOAD_BY_DLC[dlc] == payload_size) {
+            return dlc;
+        }
+    }
+    return 16U;
+}
+
+}  // namespace shape_impl
+
+/**
+ * @brief The fixed layout of the CAN-CC or CAN-FD frames of a port whose frame shape is set by its configuration,
+ * e.g. a slave that only sends 8-byte CC frames with 11-bit identifiers. Every offset and length, the CRC width and
+ * the encoded format header are constants, so ReadShapedFrame() and WriteShapedFrame() compile to straight-line code
+ * for the shape.
+ *
+ * The payload length must be one a DLC encodes exactly (0 to 8, 12, 16, 20, 24, 32, 48 or 64 bytes), so a frame of
+ * the shape has no DLC padding. CAN-XL frames are left to the generic functions: their cost is in the payload.
+ * @tparam PayloadSize Payload length in bytes
+ * @tparam Extended True for 29-bit identifiers (IDE)
+ * @tparam TimeToLive True if the frames carry a Time to Live byte (TTL)
+ * @tparam WordAligned True if the frames are padded to an even length (WA)
+ * @tparam Fd True for CAN-FD frames; defaults to CAN-FD only for payloads longer than a CAN-CC payload
+ */
+template <size_t PayloadSize, bool Extended = false, bool TimeToLive = false, bool WordAligned = false,
+          bool Fd = (PayloadSize > format::MAX_CC_PAYLOAD_SIZE)>
+struct FrameShape {
+    static_assert(shape_impl::GetExactDlc(PayloadSize) < 16U, "the payload length must be encoded exactly by a DLC");
+    static_assert(Fd || PayloadSize <= format::MAX_CC_PAYLOAD_SIZE, "CAN-CC payloads are at most 8 bytes");
+#ifndef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
+    static_assert(!Fd, "CAN-FD frames are not enabled (CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE)");
+#endif
+
+    static constexpr size_t PAYLOAD_SIZE = PayloadSize;
+    static constexpr bool IDE = Extended;
+    static constexpr bool TTL = TimeToLive;
+    static constexpr bool WA = WordAligned;
+    static constexpr bool FDF = Fd;
+
+    static constexpr uint16_t RAW_FORMAT_HEADER = static_cast<uint16_t>(
+        (shape_impl::GetExactDlc(PayloadSize) & format::HEADER_DLC_MASK) | (IDE ? format::HEADER_IDE_MASK : 0U) |
+        (FDF ? format::HEADER_FDF_MASK : 0U) | (TTL ? format::HEADER_TTL_MASK : 0U) |
+        ((WA ? format::HEADER_WA_MASK : 0U) << 8U));
+    static constexpr uint16_t ENCODED_FORMAT_HEADER = format::Secded16Encode11Bitwise(RAW_FORMAT_HEADER);
+
+    static constexpr size_t CAN_ID_POSITION = format::PREAMBLE_SIZE + format::FORMAT_HEADER_SIZE;
+    static constexpr size_t CAN_ID_SIZE =
+        IDE ? format::CAN_IDENTIFIER_SIZE + format::CAN_IDENTIFIER_EXTENSION_SIZE : format::CAN_IDENTIFIER_SIZE;
+    static constexpr size_t TTL_POSITION = CAN_ID_POSITION + CAN_ID_SIZE;
+    static constexpr size_t PAYLOAD_POSITION = TTL_POSITION + (TTL ? format::TIME_TO_LIVE_SIZE : 0U);
+    static constexpr size_t CRC_SIZE = format::GetCrcLengthFromPayloadLength(PayloadSize);
+    static constexpr size_t PADDING_SIZE =
+        format::GetAlignmentPaddingLength(PAYLOAD_POSITION + PayloadSize + CRC_SIZE, WA ? 2U : 1U);
+    static constexpr size_t CRC_POSITION = PAYLOAD_POSITION + PayloadSize + PADDING_SIZE;
+    static constexpr size_t FRAME_LENGTH = CRC_POSITION + CRC_SIZE;
+
+    /**
+     * @brief Check whether a frame has this shape. RTR, BRS and ESI are carried in the identifier and may take any
+     * value.
+     */
+    static bool Matches(const Frame& frame) {
+        return (frame.can_flags.IDE == IDE) && (frame.can_flags.TTL == TTL) && (frame.can_flags.WA == WA) &&
+               !frame.can_flags.DWA && (frame.can_flags.FDF == FDF) && !frame.can_flags.XLF &&
+               (frame.payload.size() == PayloadSize);
+    }
+};
+
+namespace frame_writer {
+
+/**
+ * @brief Writes a frame of a known shape to a byte stream writer, with the layout fixed at compile time. A frame that
+ * does not have the shape is written by WriteFrame(), so the result is always that of WriteFrame().
+ * @tparam Shape The FrameShape of the port
+ * @param stream Reference to the byte stream writer to write the frame to
+ * @param frame Reference to the Frame object to write
+ * @return On success, void; on failure, the error code
+ */
+template <typename Shape>
+etl::expected<void, FrameWriteError> WriteShapedFrame(etl::byte_stream_writer& stream, const Frame& frame) {
+    if (!Shape::Matches(frame)) {
+        return WriteFrame(stream, frame);
+    }
+    if (stream.available_bytes() < Shape::FRAME_LENGTH) {
+        return etl::unexpected(FrameWriteError::BufferTooShort);
+    }
+    uint8_t* const out = reinterpret_cast<uint8_t*>(stream.free_data().data());
+    out[0] = format::PREAMBLE_BYTE;
+    out[1] = format::PREAMBLE_BYTE;
+    out[2] = static_cast<uint8_t>(Shape::ENCODED_FORMAT_HEADER >> 8U);
+    out[3] = static_cast<uint8_t>(Shape::ENCODED_FORMAT_HEADER);
+
+    const uint8_t high_byte_flags = (frame.can_flags.RTR ? format::CID_RTR_MASK : 0U) |
+                                    (frame.can_flags.BRS ? format::CID_BRS_MASK : 0U) |
+                                    (frame.can_flags.ESI ? format::CID_ESI_MASK : 0U);
+    uint8_t* const cid = out + Shape::CAN_ID_POSITION;
+    if constexpr (Shape::IDE) {
+        cid[0] = static_cast<uint8_t>((frame.can_identifier >> 24U) | high_byte_flags);
+        cid[1] = static_cast<uint8_t>(frame.can_identifier >> 16U);
+        cid[2] = static_cast<uint8_t>(frame.can_identifier >> 8U);
+        cid[3] = static_cast<uint8_t>(frame.can_identifier);
+    } else {
+        cid[0] = static_cast<uint8_t>((frame.can_identifier >> 8U) | high_byte_flags);
+        cid[1] = static_cast<uint8_t>(frame.can_identifier);
+    }
+    if constexpr (Shape::TTL) {
+        out[Shape::TTL_POSITION] = frame.time_to_live;
+    }
+    if constexpr (Shape::PAYLOAD_SIZE > 0U) {
+        std::memcpy(out + Shape::PAYLOAD_POSITION, frame.payload.data(), Shape::PAYLOAD_SIZE);
+    }
+    if constexpr (Shape::PADDING_SIZE > 0U) {
+        out[Shape::CRC_POSITION - 1U] = 0U;
+    }
+
+    const etl::span<const uint8_t> crc_region(out + format::PREAMBLE_SIZE, Shape::CRC_POSITION - format::PREAMBLE_SIZE);
+    uint8_t* const crc = out + Shape::CRC_POSITION;
+    if constexpr (Shape::CRC_SIZE == format::LONG_CRC_SIZE) {
+        const uint32_t value = algorithms::ComputeCrc32(crc_region);
+        crc[0] = static_cast<uint8_t>(value >> 24U);
+        crc[1] = static_cast<uint8_t>(value >> 16U);
+        crc[2] = static_cast<uint8_t>(value >> 8U);
+        crc[3] = static_cast<uint8_t>(value);
+    } else {
+        const uint16_t value = algorithms::ComputeCrc16(crc_region);
+        crc[0] = static_cast<uint8_t>(value >> 8U);
+        crc[1] = static_cast<uint8_t>(value);
+    }
+    stream.skip<uint8_t>(Shape::FRAME_LENGTH);
+    return {};
+}
+
+}  // namespace frame_writer
+
+namespace frame_reader {
+
+/**
+ * @brief Reads a frame of a known shape from a byte stream reader, with the layout fixed at compile time. The frame is
+ * taken on the fast path when the buffer holds a whole frame of the shape, its preamble and format header are exactly
+ * those of the shape and its CRC matches; anything else (another shape, a corrected header bit, a short buffer or a
+ * bad CRC) is read by ReadFrame(), so the result and the stream position are always those of ReadFrame().
+ * @tparam Shape The FrameShape of the port
+ * @param stream Reference to the byte stream reader to read from
+ * @param out_frame Reference to the Frame object to read into; its payload points into the stream's buffer
+ * @return On success, the FrameReadResult; on failure, the error code
+ */
+template <typename Shape>
+etl::expected<FrameReadResult, FrameParseError> ReadShapedFrame(etl::byte_stream_reader& stream, Frame& out_frame) {
+    const etl::span<const char> available = stream.free_data();
+    if (available.size() < Shape::FRAME_LENGTH) {
+        return ReadFrame(stream, out_frame);
+    }
+    const uint8_t* const in = reinterpret_cast<const uint8_t*>(available.data());
+    if ((in[0] != format::PREAMBLE_BYTE) || (in[1] != format::PREAMBLE_BYTE) ||
+        (in[2] != static_cast<uint8_t>(Shape::ENCODED_FORMAT_HEADER >> 8U)) ||
+        (in[3] != static_cast<uint8_t>(Shape::ENCODED_FORMAT_HEADER))) {
+        return ReadFrame(stream, out_frame);
+    }
+
+    const etl::span<const uint8_t> crc_region(in + format::PREAMBLE_SIZE, Shape::CRC_POSITION - format::PREAMBLE_SIZE);
+    const uint8_t* const crc = in + Shape::CRC_POSITION;
+    bool crc_matches;
+    if constexpr (Shape::CRC_SIZE == format::LONG_CRC_SIZE) {
+        const uint32_t stored = (static_cast<uint32_t>(crc[0]) << 24U) | (static_cast<uint32_t>(crc[1]) << 16U) |
+                                (static_cast<uint32_t>(crc[2]) << 8U) | static_cast<uint32_t>(crc[3]);
+        crc_matches = algorithms::ComputeCrc32(crc_region) == stored;
+    } else {
+        const uint16_t stored = static_cast<uint16_t>((static_cast<uint16_t>(crc[0]) << 8U) | crc[1]);
+        crc_matches = algorithms::ComputeCrc16(crc_region) == stored;
+    }
+    if (!crc_matches) {
+        return ReadFrame(stream, out_frame);  // reports the error as ReadFrame() does
+    }
+
+    out_frame.Reset();
+    out_frame.can_flags.IDE = Shape::IDE;
+    out_frame.can_flags.FDF = Shape::FDF;
+    out_frame.can_flags.TTL = Shape::TTL;
+    out_frame.can_flags.WA = Shape::WA;
+    const uint8_t* const cid = in + Shape::CAN_ID_POSITION;
+    out_frame.can_flags.RTR = (cid[0] & format::CID_RTR_MASK) != 0U;
+    out_frame.can_flags.BRS = (cid[0] & format::CID_BRS_MASK) != 0U;
+    out_frame.can_flags.ESI = (cid[0] & format::CID_ESI_MASK) != 0U;
+    const uint8_t b0 =
+        cid[0] & static_cast<uint8_t>(~(format::CID_RTR_MASK | format::CID_BRS_MASK | format::CID_ESI_MASK));
+    if constexpr (Shape::IDE) {
+        out_frame.can_identifier = (static_cast<uint32_t>(b0) << 24U) | (static_cast<uint32_t>(cid[1]) << 16U) |
+                                   (static_cast<uint32_t>(cid[2]) << 8U) | static_cast<uint32_t>(cid[3]);
+    } else {
+        out_frame.can_identifier = (static_cast<uint32_t>(b0) << 8U) | static_cast<uint32_t>(cid[1]);
+    }
+    if constexpr (Shape::TTL) {
+        out_frame.time_to_live = in[Shape::TTL_POSITION];
+    }
+    out_frame.payload = etl::span<uint8_t>(const_cast<uint8_t*>(in + Shape::PAYLOAD_POSITION), Shape::PAYLOAD_SIZE);
+    stream.skip<uint8_t>(Shape::FRAME_LENGTH);
+    impl::CountFrame(out_frame.can_flags, Shape::FRAME_LENGTH, false, 0U);
+
+    FrameReadResult result{};
+    result.dlc_corrected = false;
+    return result;
+}
+
+}  // namespace frame_reader
+
+}  // namespace spiopen
@@ -0,0 +1,115 @@
+/*
+SpIOpen Frame Statistics : Receive-path counters for the frame reader (CONFIG_SPIOPEN_FRAME_READER_STATISTICS).
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "spiopen_frame.h"
+#include "spiopen_frame_reader.h"
+
+#ifdef CONFIG_SPIOPEN_FRAME_READER_STATISTICS
+#include <atomic>
+#endif
+
+namespace spiopen::frame_reader {
+
+// one counter per FrameParseError value, indexed by the value (index 0 is unused)
+constexpr size_t FRAME_PARSE_ERROR_COUNT = static_cast<size_t>(FrameParseError::WideAlignmentNotSupported) + 1U;
+constexpr size_t BIT_SLIP_COUNTS = 8U;
+
+/**
+ * @brief A snapshot of the receive-path counters. Every counter is 32 bits and wraps around, so rates should be taken
+ * from the difference between two snapshots.
+ *
+ * Frames are counted by the functions that hand a frame (or an error) to the application: ReadFrame(),
+ * ReadAndCopyFrame(), ReadFrameView(), ParseAll() and FrameStreamParser. Helpers they use (PeekFrameLength(), the
+ * preamble searches) are not counted, so each frame is counted once.
+ */
+struct ReaderStatistics {
+    uint32_t cc_frames;          // valid CAN-CC frames
+    uint32_t fd_frames;          // valid CAN-FD frames
+    uint32_t xl_frames;          // valid CAN-XL frames
+    uint32_t frame_bytes;        // wire bytes of the valid frames, preamble to CRC
+    uint32_t corrected_headers;  // valid frames with a single bit error corrected in the format header or XL length
+    std::array<uint32_t, FRAME_PARSE_ERROR_COUNT> parse_errors;  // failed (or filtered) reads by FrameParseError value
+    std::array<uint32_t, BIT_SLIP_COUNTS> bit_slips;             // valid frames by bit slip count
+    uint32_t resync_bytes;  // bytes passed over by ParseAll() and FrameStreamParser that were not in a valid frame
+
+    uint32_t GetParseErrorCount(const FrameParseError error) const {
+        return parse_errors[static_cast<size_t>(error)];
+    }
+};
+
+#ifdef CONFIG_SPIOPEN_FRAME_READER_STATISTICS
+/**
+ * @brief Take a snapshot of the receive-path counters. Each counter is read on its own, so a snapshot taken while
+ * frames are being read may be part way through counting one.
+ */
+ReaderStatistics GetReaderStatistics();
+
+/**
+ * @brief Set every receive-path counter to zero
+ */
+void ResetReaderStatistics();
+#endif
+
+namespace impl {
+
+#ifdef CONFIG_SPIOPEN_FRAME_READER_STATISTICS
+// Only ever incremented, and read on their own, so relaxed ordering is enough and the counting does not add barriers
+// to the receive path
+struct ReaderStatisticsCounters {
+    std::atomic<uint32_t> cc_frames;
+    std::atomic<uint32_t> fd_frames;
+    std::atomic<uint32_t> xl_frames;
+    std::atomic<uint32_t> frame_bytes;
+    std::atomic<uint32_t> corrected_headers;
+    std::array<std::atomic<uint32_t>, FRAME_PARSE_ERROR_COUNT> parse_errors;
+    std::array<std::atomic<uint32_t>, BIT_SLIP_COUNTS> bit_slips;
+    std::atomic<uint32_t> resync_bytes;
+};
+
+extern ReaderStatisticsCounters reader_statistics_counters;
+
+inline void CountFrame(const Frame::Flags& flags, const size_t frame_length, const bool header_corrected,
+                       const uint8_t bit_slip_count) {
+    ReaderStatisticsCounters& counters = reader_statistics_counters;
+    std::atomic<uint32_t>& kind =
+        flags.XLF ? counters.xl_frames : (flags.FDF ? counters.fd_frames : counters.cc_frames);
+    kind.fetch_add(1U, std::memory_order_relaxed);
+    counters.frame_bytes.fetch_add(static_cast<uint32_t>(frame_length), std::memory_order_relaxed);
+    if (header_corrected) {
+        counters.corrected_headers.fetch_add(1U, std::memory_order_relaxed);
+    }
+    counters.bit_slips[bit_slip_count & 0x07U].fetch_add(1U, std::memory_order_relaxed);
+}
+
+inline void CountParseError(const FrameParseError error) {
+    const size_t index = static_cast<size_t>(error);
+    if (index < FRAME_PARSE_ERROR_COUNT) {
+        reader_statistics_counters.parse_errors[index].fetch_add(1U, std::memory_order_relaxed);
+    }
+}
+
+inline void CountResyncBytes(const size_t byte_count) {
+    if (byte_count > 0U) {
+        reader_statistics_counters.resync_bytes.fetch_add(static_cast<uint32_t>(byte_count),
+                                                          std::memory_order_relaxed);
+    }
+}
+#else
+// statistics disabled: the counting compiles away
+inline void CountFrame(const Frame::Flags&, size_t, bool, uint8_t) {}
+inline void CountParseError(FrameParseError) {}
+inline void CountResyncBytes(size_t) {}
+#endif
+
+}  // namespace impl
+
+}  // namespace spiopen::frame_reader
@@ -0,0 +1,145 @@
+/*
+SpIOpen Frame Stream Parser : Incremental parsing of SpIOpen frames from input that arrives in chunks.
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "etl/span.h"
+#include "spiopen_frame.h"
+#include "spiopen_frame_crc.h"
+#include "spiopen_frame_reader.h"
+
+namespace spiopen::frame_reader {
+
+/** Outcome of a FrameStreamParser::Feed() call. */
+enum class FeedStatus : uint8_t {
+    NeedMoreData,   // the whole chunk was consumed without completing a frame
+    FrameComplete,  // a frame passed its CRC check; GetFrame() holds it until the next Feed() or Reset()
+    FrameDropped,   // a started frame failed to parse; the error says why and the preamble search resumes
+};
+
+/** Result of a FrameStreamParser::Feed() call. */
+struct FeedResult {
+    size_t bytes_consumed;  // bytes of the chunk used; feed the rest again after handling a completed or dropped frame
+                            // (a completed frame may leave bytes in the parser, so feed again even if none are left)
+    FeedStatus status;
+    FrameParseError error;  // reason the frame was dropped, only meaningful for FeedStatus::FrameDropped
+};
+
+/**
+ * @brief Parses SpIOpen frames from a byte stream fed in arbitrary chunks (e.g. from DMA half/full-complete
+ * callbacks), without reassembling the frame first.
+ *
+ * The parser searches for a preamble at any bit slip (see PreambleDetector), then realigns the frame into its frame
+ * buffer as the bytes arrive. It works out the frame length as soon as the format header (and XL length) is in,
+ * folds the protected region into the CRC while the frame is still arriving, and reports the frame once its CRC field
+ * is complete. Between calls it only keeps its position in the frame, so a chunk may end anywhere.
+ *
+ * A preamble can fit at more than one bit slip (the byte before an aligned frame may end in preamble bits). Like
+ * ParseAll(), the parser reads the frame at the earliest slip and, if its header or CRC check fails, tries the other
+ * slips against the bytes already received. A frame at a later slip that ends first is checked as soon as it is in,
+ * so a wrong length read at an earlier slip does not hold it back. A frame that fails at every slip is dropped and the
+ * search resumes just after its preamble byte, so a frame that starts inside it is still found.
+ *
+ * The bytes searched again (after a dropped frame, after a shorter frame found at a later slip, and the rest of the
+ * last byte of a slipped frame) are handed back through bytes_consumed when they came from the chunk just fed. Older
+ * ones are kept in the frame buffer and searched at the start of the next Feed() call.
+ */
+class FrameStreamParser {
+   public:
+    /**
+     * @param frame_buffer Buffer that completed frames are realigned into. Frames that do not fit are dropped, so it
+     * should hold the largest frame type enabled (see format::MAX_CAN_XL_FRAME_SIZE and friends).
+     */
+    explicit FrameStreamParser(etl::span<uint8_t> frame_buffer) : frame_buffer_(frame_buffer), crc_(0U) { Reset(); }
+
+    /**
+     * @brief Drop any partial frame and forget the stream history, e.g. after an idle reset of the receiver.
+     */
+    void Reset();
+
+    /**
+     * @brief Feed the next received bytes. Stops early when a frame completes or is dropped, so the caller can handle
+     * it before feeding the rest of the chunk.
+     * @param chunk The received bytes, in order
+     * @return FeedResult with the number of bytes consumed and whether a frame completed or was dropped
+     */
+    FeedResult Feed(const etl::span<const uint8_t>& chunk);
+
+    /**
+     * @brief The last completed frame. Its payload points into the frame buffer and is valid until the next Feed() or
+     * Reset().
+     */
+    const Frame& GetFrame() const { return frame_; }
+
+    /**
+     * @brief Read result of the last completed frame (whether a header field was corrected)
+     */
+    FrameReadResult GetReadResult() const { return read_result_; }
+
+    /**
+     * @brief True while a frame has been started but not yet completed
+     */
+    bool IsReceivingFrame() const { return state_ != State::SearchingPreamble; }
+
+    /**
+     * @brief Bit slip of the frame being received (or last received), 0 to 7
+     */
+    uint8_t GetBitSlipCount() const { return bit_slip_count_; }
+
+   private:
+    enum class State : uint8_t {
+        SearchingPreamble,  // feeding the preamble detector
+        ReceivingHeader,    // collecting the format header (and XL length) needed to work out the frame length
+        ReceivingBody,      // length known, collecting the rest of the frame up to the end of the CRC
+    };
+
+    FeedResult Consume(const uint8_t* data, size_t size);
+    uint8_t GetSlipsAfterTail() const;
+    void StartFrame(uint8_t slips, uint8_t last_byte);
+    void Append(const uint8_t* source, size_t count);
+    void FoldCrc();
+    size_t GetSlipBitOffset(uint8_t slip) const;
+    uint8_t GetShiftedByte(size_t bit_offset, size_t index) const;
+    void ShiftFrameBuffer(size_t bit_offset);
+    bool RetryNextSlip(FrameParseError error);
+    void KeepTail(size_t bit_offset, uint8_t search_start_bit);
+    void PrepareReplay();
+    etl::expected<size_t, FrameParseError> DecodeFrameLength(const uint8_t* bytes, size_t available, Frame& frame,
+                                                             bool& dlc_corrected, size_t& payload_length) const;
+    etl::expected<bool, FrameParseError> ParseHeaderPrefix();
+    void CheckLaterSlips();
+    bool CheckSlipCrc(size_t bit_offset, size_t payload_length, size_t frame_length) const;
+    etl::expected<void, FrameParseError> FinishFrame();
+    FeedResult DropFrame(size_t bytes_consumed, FrameParseError error);
+
+    etl::span<uint8_t> frame_buffer_;
+    PreambleDetector detector_;
+    State state_;
+    uint8_t bit_slip_count_;
+    uint8_t preamble_slips_;        // slips the current preamble fits at
+    uint8_t candidate_slips_;       // slips of the current preamble not yet tried (including the current one)
+    FrameParseError first_error_;   // error at the first slip tried, reported if every slip fails
+    uint8_t carry_;                 // last byte fed while slipped; its low bits start the next realigned byte
+    bool tail_pending_;             // the last Feed() ended a frame; its received bytes stay put until the next one
+    size_t tail_bit_offset_;        // start of the bytes to search again, in bits of the realigned bytes
+    size_t tail_bytes_;             // number of bytes to search again that were not handed back
+    uint8_t search_start_bit_;      // no frame may start before this bit of the first byte searched again
+    size_t replay_position_;        // next kept byte to search again, at the front of the frame buffer
+    size_t replay_length_;          // end of the kept bytes
+    size_t write_position_;      // realigned bytes in the frame buffer
+    size_t target_position_;     // write position at which the next parse step can run
+    size_t payload_length_;      // on-wire payload section length, once the header has been parsed
+    size_t frame_length_;        // full frame length, valid in ReceivingBody
+    size_t crc_position_;        // bytes of the protected region folded into crc_ so far
+    FrameCrc crc_;
+    Frame frame_;
+    FrameReadResult read_result_;
+};
+
+}  // namespace spiopen::frame_reader
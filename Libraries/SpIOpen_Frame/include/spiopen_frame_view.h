@@ -0,0 +1,100 @@
+/*
+SpIOpen Frame View : Lazy, zero-copy access to the fields of a validated SpIOpen frame in its wire bytes.
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "etl/byte_stream.h"
+#include "etl/expected.h"
+#include "etl/span.h"
+#include "spiopen_frame.h"
+#include "spiopen_frame_format.h"
+#include "spiopen_frame_reader.h"
+
+namespace spiopen::frame_reader {
+
+/**
+ * @brief A validated SpIOpen frame left in its wire bytes, with each field decoded only when it is asked for.
+ *
+ * ReadFrameView() does the checks ReadFrame() does (preamble, SECDED header, length and CRC) but keeps only the decoded
+ * format header and the payload length. A consumer that only needs the CAN identifier to route or drop the frame then
+ * reads two or four bytes, rather than having every field decoded into a Frame. ToFrame() decodes the rest when the
+ * frame is kept.
+ *
+ * The view points into the buffer it was read from and is only valid while that buffer is.
+ */
+class FrameView {
+   public:
+    FrameView() : wire_(), flags_({}), payload_length_(0U) {}
+
+    /**
+     * @brief True once ReadFrameView() has validated a frame into the view
+     */
+    bool IsValid() const { return !wire_.empty(); }
+
+    /**
+     * @brief The whole frame, from the start of the preamble to the end of the CRC (including padding)
+     */
+    etl::span<uint8_t> GetWireBytes() const { return wire_; }
+
+    /**
+     * @brief Flags from the format header and the first CAN identifier byte (RTR, BRS, ESI)
+     */
+    Frame::Flags GetFlags() const;
+
+    /**
+     * @brief The 11 or 29 bit CAN identifier
+     */
+    uint32_t GetCanIdentifier() const;
+
+    /**
+     * @brief The Time to Live counter, 0 if the TTL flag is not set
+     */
+    uint8_t GetTimeToLive() const;
+
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    /**
+     * @brief The XL control fields, all zero if the XLF flag is not set
+     */
+    Frame::XLControl GetXlControl() const;
+#endif
+
+    /**
+     * @brief The payload as on the wire (FD payloads include their DLC padding), pointing into the wire bytes
+     */
+    etl::span<uint8_t> GetPayload() const {
+        return wire_.subspan(format::PREAMBLE_SIZE + GetHeaderLength(), payload_length_);
+    }
+
+    /**
+     * @brief Decode every field into a Frame, as ReadFrame() would have. The payload points into the wire bytes.
+     */
+    void ToFrame(Frame& out_frame) const;
+
+   private:
+    friend etl::expected<FrameReadResult, FrameParseError> ReadFrameView(etl::byte_stream_reader& stream,
+                                                                         FrameView& out_view);
+
+    size_t GetCanIdOffset() const;
+    size_t GetHeaderLength() const;
+
+    etl::span<uint8_t> wire_;
+    Frame::Flags flags_;     // format header flags, corrected by SECDED; RTR, BRS and ESI are left in the wire bytes
+    size_t payload_length_;  // on-wire payload section length
+};
+
+/**
+ * @brief Validate a SpIOpen frame in a byte stream without decoding its fields.
+ * @param stream Byte stream reader positioned at the start of the frame (preamble). Uses big-endian. On success it is
+ * advanced past the frame.
+ * @param out_view The view to point at the frame; left empty on failure
+ * @return On success, FrameReadResult with dlc_corrected flag; on failure, the same parse error ReadFrame() returns
+ */
+etl::expected<FrameReadResult, FrameParseError> ReadFrameView(etl::byte_stream_reader& stream, FrameView& out_view);
+
+}  // namespace spiopen::frame_reader
@@ -6,26 +6,30 @@ SPDX-License-Identifier: Apache-2.0
 */
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
 
 #include "etl/byte_stream.h"
 #include "etl/expected.h"
+#include "etl/span.h"
 #include "spiopen_frame.h"
+#include "spiopen_frame_crc.h"
 #include "spiopen_frame_format.h"
 
 namespace spiopen::frame_writer {
 
 /** Error codes for frame write operations. */
 enum class FrameWriteError : uint8_t {
-    InvalidPayloadLength = 1,  // The data length is invalid for the frame type
-    InvalidFrameLength,        // The frame length is invalid for the frame type
-    InvalidPayloadPointer,     // The payload pointer is invalid or NULL
-    BufferTooShort,            // The buffer is too short to write the frame
-    InvalidBufferPointer,      // The buffer pointer is invalid or NULL
-    InvalidFramePointer,       // The frame pointer is invalid or NULL
-    CanFdNotSupported,         // CAN-FD not supported by the frame pool
-    CanXlNotSupported,         // CAN-XL not supported by the frame pool
+    InvalidPayloadLength = 1,   // The data length is invalid for the frame type
+    InvalidFrameLength,         // The frame length is invalid for the frame type
+    InvalidPayloadPointer,      // The payload pointer is invalid or NULL
+    BufferTooShort,             // The buffer is too short to write the frame
+    InvalidBufferPointer,       // The buffer pointer is invalid or NULL
+    InvalidFramePointer,        // The frame pointer is invalid or NULL
+    CanFdNotSupported,          // CAN-FD not supported by the frame pool
+    CanXlNotSupported,          // CAN-XL not supported by the frame pool
+    WideAlignmentNotSupported,  // DWA flag set but 4 and 8 byte alignment are not supported by the frame pool
 };
 
 /**
@@ -36,6 +40,166 @@ enum class FrameWriteError : uint8_t {
  */
 etl::expected<void, FrameWriteError> WriteFrame(etl::byte_stream_writer& stream, const Frame& frame);
 
+/** One contiguous piece of an encoded frame, as an entry of a DMA linked list or an iovec for writev(). */
+struct FrameSegment {
+    const uint8_t* data;
+    size_t length;
+};
+
+/**
+ * @brief An encoded frame as up to three segments that are sent one after the other: the header (preamble to TTL),
+ * the payload, borrowed from the Frame rather than copied, and the trailer (FD DLC and WA padding, and the CRC). The
+ * payload segment is left out for an empty payload.
+ *
+ * The header and trailer are stored in the object, and the payload segment points to the Frame's payload, so the
+ * segments are only valid while both are and the payload is not changed. The object cannot be copied, as its segments
+ * point into itself.
+ */
+class FrameSegments {
+   public:
+    static constexpr size_t MAX_SEGMENTS = 3U;
+    static constexpr size_t MAX_HEADER_SIZE = format::MAX_CAN_XL_HEADER_SIZE;
+    // FD DLC padding is at most 15 bytes (a 49 byte payload in a 64 byte payload section)
+    static constexpr size_t MAX_FD_DLC_PADDING_SIZE =
+        format::CAN_FD_PAYLOAD_BY_DLC[15] - format::CAN_FD_PAYLOAD_BY_DLC[14] - 1U;
+    static constexpr size_t MAX_TRAILER_SIZE =
+        MAX_FD_DLC_PADDING_SIZE + format::MAX_PADDING_SIZE + format::LONG_CRC_SIZE;
+
+    FrameSegments() : segments_{}, segment_count_(0U), frame_length_(0U) {}
+    FrameSegments(const FrameSegments&) = delete;
+    FrameSegments& operator=(const FrameSegments&) = delete;
+
+    /** The segments in the order they are sent; empty until WriteFrameSegments() succeeds */
+    etl::span<const FrameSegment> GetSegments() const {
+        return etl::span<const FrameSegment>(segments_.data(), segment_count_);
+    }
+
+    /** The length of the frame on the wire: the sum of the segment lengths */
+    size_t GetFrameLength() const { return frame_length_; }
+
+   private:
+    friend etl::expected<void, FrameWriteError> WriteFrameSegments(const Frame& frame, FrameSegments& segments);
+
+    std::array<uint8_t, MAX_HEADER_SIZE> header_;
+    std::array<uint8_t, MAX_TRAILER_SIZE> trailer_;
+    std::array<FrameSegment, MAX_SEGMENTS> segments_;
+    size_t segment_count_;
+    size_t frame_length_;
+};
+
+/**
+ * @brief Encodes a frame without copying its payload, for a DMA controller with scatter-gather or writev(). The header
+ * and trailer are written to the segments object, and the CRC is computed over the payload where it is. The segments
+ * sent one after the other are the bytes WriteFrame() writes.
+ * @param frame Reference to the Frame object to encode; its payload must stay valid while the segments are used
+ * @param segments Receives the header, payload and trailer segments
+ * @return On success, void; on failure, the error code, and the segments are left empty
+ */
+etl::expected<void, FrameWriteError> WriteFrameSegments(const Frame& frame, FrameSegments& segments);
+
+/**
+ * @brief A frame sent every cycle with the same identifier, flags, TTL and payload length, pre-encoded so each cycle
+ * only writes the payload, e.g. a transmit PDO.
+ *
+ * PrepareFrameTemplate() checks the frame once and stores its preamble and header fields (format header, XL fields,
+ * CAN identifier and TTL) with the CRC state after them. WriteFrame() with the template then copies the stored header,
+ * copies the payload and finishes the CRC from the stored state, so the cost of a cycle is the payload alone.
+ */
+class CyclicFrameTemplate {
+   public:
+    CyclicFrameTemplate()
+        : header_crc_(0U), header_length_(0U), payload_size_(0U), crc_position_(0U), frame_length_(0U) {}
+
+    /** The length of each frame written from the template, or 0 if it is not prepared */
+    size_t GetFrameLength() const { return frame_length_; }
+
+    /** The payload length each frame written from the template must have */
+    size_t GetPayloadSize() const { return payload_size_; }
+
+   private:
+    friend etl::expected<void, FrameWriteError> PrepareFrameTemplate(const Frame& frame,
+                                                                     CyclicFrameTemplate& frame_template);
+    friend etl::expected<void, FrameWriteError> WriteFrame(etl::byte_stream_writer& stream,
+                                                           const CyclicFrameTemplate& frame_template,
+                                                           const etl::span<const uint8_t>& payload);
+
+    std::array<uint8_t, format::MAX_CAN_XL_HEADER_SIZE> header_;  // preamble to TTL
+    FrameCrc header_crc_;                                          // CRC over the header, after the preamble
+    size_t header_length_;
+    size_t payload_size_;
+    size_t crc_position_;
+    size_t frame_length_;
+};
+
+/**
+ * @brief Pre-encodes a frame's header for WriteFrame() with a template. Everything but the payload data is taken from
+ * the frame and checked as WriteFrame() checks it; only the length of the payload is used.
+ * @param frame Reference to the Frame to take the identifier, flags, TTL, XL control and payload length from
+ * @param frame_template Receives the pre-encoded header
+ * @return On success, void; on failure, the error code, and the template is left unprepared
+ */
+etl::expected<void, FrameWriteError> PrepareFrameTemplate(const Frame& frame, CyclicFrameTemplate& frame_template);
+
+/**
+ * @brief Writes a frame from a prepared template with a new payload to a byte stream writer. The bytes are those
+ * WriteFrame() writes for the template's frame with this payload.
+ * @param stream Reference to the byte stream writer to write the frame to
+ * @param frame_template The template, prepared with PrepareFrameTemplate()
+ * @param payload The payload for this cycle; must be the template's payload length
+ * @return On success, void; on failure, the error code (InvalidFrameLength if the template is not prepared)
+ */
+etl::expected<void, FrameWriteError> WriteFrame(etl::byte_stream_writer& stream,
+                                                const CyclicFrameTemplate& frame_template,
+                                                const etl::span<const uint8_t>& payload);
+
+/** Layout of the frames written by WriteFrames(). The zero initialized options ({}) write the frames back to back. */
+struct BatchWriteOptions {
+    size_t frame_alignment;  // Each frame starts at a multiple of this many bytes from the start of the batch (0 or 1
+                             // for no alignment), e.g. the word size of the DMA transfer
+    size_t inter_frame_gap;  // Minimum number of idle bytes between the end of a frame and the start of the next
+    uint8_t idle_byte;       // Value written to the gap and alignment bytes between frames
+};
+
+/**
+ * @brief Works out the length of a batch of frames written by WriteFrames(), e.g. to size a DMA transfer before the
+ * frames are written. Every frame is checked as WriteFrame() would check it.
+ * @param frames The frames, in the order they are to be sent
+ * @param options The alignment and gap between the frames
+ * @return On success, the length of the batch from the start of the first frame to the end of the last; on failure,
+ * the error code of the first frame that cannot be written
+ */
+etl::expected<size_t, FrameWriteError> GetBatchLength(const etl::span<const Frame>& frames,
+                                                      const BatchWriteOptions& options);
+
+/**
+ * @brief Writes a batch of frames back to back to a byte stream writer, e.g. to build one SPI burst for a single DMA
+ * transfer. Each frame is checked once, as it is written. The stream is only moved on if the whole batch is written; on
+ * failure it is left where it was, although the frames before the failing one may have been stored in its free space.
+ * @param stream Reference to the byte stream writer to write the frames to
+ * @param frames The frames, in the order they are to be sent
+ * @param frame_offsets Receives the offset of each frame's preamble from the start of the batch (the stream position
+ * at the call); must hold at least one offset per frame
+ * @param options The alignment and gap between the frames
+ * @return On success, the length of the batch (as GetBatchLength()); on failure, the error code of the first frame that
+ * cannot be written, or BufferTooShort if the stream or frame_offsets cannot hold the batch
+ */
+etl::expected<size_t, FrameWriteError> WriteFrames(etl::byte_stream_writer& stream,
+                                                   const etl::span<const Frame>& frames,
+                                                   const etl::span<size_t>& frame_offsets,
+                                                   const BatchWriteOptions& options);
+
+/**
+ * @brief Decrements the Time to Live counter of an already encoded frame in place, e.g. before forwarding it to the
+ * next node of the chain. Only the TTL byte and the CRC are rewritten; the CRC is patched with the change caused by the
+ * new TTL value instead of being recomputed, so the cost does not depend on the payload size.
+ * @param encoded_frame The encoded frame starting at its preamble, as written by WriteFrame or copied by
+ * ReadAndCopyFrame
+ * @param frame The Frame that was written to or read from encoded_frame. Its time_to_live is updated as well.
+ * @return On success, true if the Time to Live is now expired (as Frame::DecrementAndCheckIfTimeToLiveExpired) and
+ * false otherwise or if the frame has no Time to Live; on failure, the error code
+ */
+etl::expected<bool, FrameWriteError> DecrementTimeToLiveInPlace(etl::span<uint8_t> encoded_frame, Frame& frame);
+
 // Helper functions for writing a SpIOpen frame to a byte array buffer. Not to be accessed directly.
 namespace impl {
 etl::expected<void, FrameWriteError> ValidateFrame(etl::byte_stream_writer& stream, const Frame& frame);
@@ -0,0 +1,225 @@
+/*
+SpIOpen Frame Algorithm Implementation (Carry-less Multiply / Host)
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+
+CRC folding with carry-less multiplication (x86-64 PCLMULQDQ, ARMv8 PMULL), meant for master-side gateways that
+parse every frame of several backplanes. Blocks of 16 bytes are folded together four at a time, the folded remainder
+is Barrett-reduced to the CRC register and the sub-block tail is finished with slicing tables. The CRC-16 is folded
+through the same 32-bit engine using the polynomial scaled by x^16.
+
+The instruction set is chosen at configure time: CMake enables -mpclmul / +crypto for this file when the compiler
+supports it (SPIOPEN_FRAME_ALGORITHM_USE_CLMUL). Without it the file builds the portable slicing-by-8 fallback, so
+the same source is always safe to select. SECDED is the shared software implementation.
+*/
+
+#include "spiopen_frame_algorithms.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "../common/spiopen_frame_crc_slicing.h"
+#include "../common/spiopen_frame_secded_software.h"
+#include "etl/span.h"
+
+#if defined(__x86_64__) && defined(__PCLMUL__)
+#include <emmintrin.h>
+#include <wmmintrin.h>
+#define SPIOPEN_FRAME_CLMUL_AVAILABLE 1
+#elif defined(__aarch64__) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+#include <arm_neon.h>
+#define SPIOPEN_FRAME_CLMUL_AVAILABLE 1
+#endif
+
+namespace spiopen::algorithms {
+
+namespace {
+constexpr size_t crc_slices = 8U;
+constexpr slicing::CrcTables<uint16_t, crc_slices> crc16_tables =
+    slicing::MakeCrcTables<uint16_t, slicing::crc16_polynomial, crc_slices>();
+constexpr slicing::CrcTables<uint32_t, crc_slices> crc32_tables =
+    slicing::MakeCrcTables<uint32_t, slicing::crc32_polynomial, crc_slices>();
+
+#ifdef SPIOPEN_FRAME_CLMUL_AVAILABLE
+constexpr size_t fold_block_size = 16U;
+constexpr size_t fold_lanes = 4U;
+
+// 128-bit polynomial, most significant coefficient first (matches the MSB-first bit order on the wire)
+struct Poly128 {
+    uint64_t high;
+    uint64_t low;
+};
+
+// Folding constants for a degree-32 polynomial. x^N entries are x^N mod P.
+struct FoldConstants {
+    uint64_t x576;
+    uint64_t x512;
+    uint64_t x192;
+    uint64_t x128;
+    uint64_t x96;
+    uint64_t x64;
+    uint64_t mu;          // floor(x^64 / P), used for the final Barrett reduction
+    uint64_t polynomial;  // P including the x^32 term
+};
+
+constexpr uint64_t XPowModP(const size_t power, const uint64_t polynomial) {
+    uint64_t remainder = 1U;
+    for (size_t i = 0U; i < power; ++i) {
+        remainder <<= 1U;
+        if ((remainder & (static_cast<uint64_t>(1U) << 32U)) != 0U) {
+            remainder ^= polynomial;
+        }
+    }
+    return remainder;
+}
+
+constexpr uint64_t BarrettMu(const uint64_t polynomial) {
+    // x^64 / P: the leading quotient bit is always x^32, which leaves (P - x^32) * x^32 as the running remainder.
+    uint64_t quotient = static_cast<uint64_t>(1U) << 32U;
+    uint64_t remainder = (polynomial & 0xFFFFFFFFU) << 32U;
+    for (size_t bit = 63U; bit >= 32U; --bit) {
+        if ((remainder & (static_cast<uint64_t>(1U) << bit)) != 0U) {
+            quotient |= static_cast<uint64_t>(1U) << (bit - 32U);
+            remainder ^= polynomial << (bit - 32U);
+        }
+    }
+    return quotient;
+}
+
+constexpr FoldConstants MakeFoldConstants(const uint64_t polynomial) {
+    return FoldConstants{XPowModP(576U, polynomial), XPowModP(512U, polynomial), XPowModP(192U, polynomial),
+                         XPowModP(128U, polynomial), XPowModP(96U, polynomial),  XPowModP(64U, polynomial),
+                         BarrettMu(polynomial),      polynomial};
+}
+
+constexpr FoldConstants crc32_fold_constants =
+    MakeFoldConstants((static_cast<uint64_t>(1U) << 32U) | slicing::crc32_polynomial);
+// CRC16 register r over P equals (r * x^16) over P * x^16, so the 32-bit engine computes it with the scaled polynomial
+constexpr FoldConstants crc16_fold_constants =
+    MakeFoldConstants(((static_cast<uint64_t>(1U) << 16U) | slicing::crc16_polynomial) << 16U);
+
+inline Poly128 CarrylessMultiply(const uint64_t a, const uint64_t b) {
+#if defined(__x86_64__)
+    const __m128i product = _mm_clmulepi64_si128(_mm_cvtsi64_si128(static_cast<long long>(a)),
+                                                 _mm_cvtsi64_si128(static_cast<long long>(b)), 0x00);
+    return Poly128{static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(product, product))),
+                   static_cast<uint64_t>(_mm_cvtsi128_si64(product))};
+#else
+    const uint64x2_t product = vreinterpretq_u64_p128(vmull_p64(static_cast<poly64_t>(a), static_cast<poly64_t>(b)));
+    return Poly128{vgetq_lane_u64(product, 1), vgetq_lane_u64(product, 0)};
+#endif
+}
+
+inline uint64_t LoadBigEndian64(const uint8_t* data) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    value = __builtin_bswap64(value);
+#endif
+    return value;
+}
+
+inline Poly128 LoadBlock(const uint8_t* data) { return Poly128{LoadBigEndian64(data), LoadBigEndian64(data + 8U)}; }
+
+// value * x^(distance) + block, where distance is encoded by the (x^(distance+64), x^distance) constant pair
+inline Poly128 Fold(const Poly128& value, const uint64_t high_constant, const uint64_t low_constant,
+                    const Poly128& block) {
+    const Poly128 high = CarrylessMultiply(value.high, high_constant);
+    const Poly128 low = CarrylessMultiply(value.low, low_constant);
+    return Poly128{high.high ^ low.high ^ block.high, high.low ^ low.low ^ block.low};
+}
+
+/**
+ * @brief Fold all complete 16-byte blocks of the data into the CRC register.
+ * @param crc Current 32-bit CRC register (for the CRC16 engine, the 16-bit register shifted up by 16)
+ * @param data Advanced past the consumed blocks
+ * @param length Reduced by the consumed blocks. Must be at least one block on entry.
+ * @return The updated CRC register
+ */
+uint32_t FoldBlocks(const uint32_t crc, const uint8_t*& data, size_t& length, const FoldConstants& constants) {
+    Poly128 accumulator = LoadBlock(data);
+    accumulator.high ^= static_cast<uint64_t>(crc) << 32U;  // the register is xored into the first message bits
+    data += fold_block_size;
+    length -= fold_block_size;
+
+    if (length >= fold_block_size * fold_lanes) {
+        // four independent accumulators hide the multiplier latency
+        Poly128 lanes[fold_lanes] = {accumulator, LoadBlock(data), LoadBlock(data + fold_block_size),
+                                     LoadBlock(data + 2U * fold_block_size)};
+        data += fold_block_size * (fold_lanes - 1U);
+        length -= fold_block_size * (fold_lanes - 1U);
+        while (length >= fold_block_size * fold_lanes) {
+            for (size_t lane = 0U; lane < fold_lanes; ++lane) {
+                lanes[lane] = Fold(lanes[lane], constants.x576, constants.x512, LoadBlock(data));
+                data += fold_block_size;
+            }
+            length -= fold_block_size * fold_lanes;
+        }
+        accumulator = lanes[0];
+        for (size_t lane = 1U; lane < fold_lanes; ++lane) {
+            accumulator = Fold(accumulator, constants.x192, constants.x128, lanes[lane]);
+        }
+    }
+
+    while (length >= fold_block_size) {
+        accumulator = Fold(accumulator, constants.x192, constants.x128, LoadBlock(data));
+        data += fold_block_size;
+        length -= fold_block_size;
+    }
+
+    // (accumulator * x^32) mod P: first fold the 160-bit product down to 96 and then 64 bits ...
+    const Poly128 high_part = CarrylessMultiply(accumulator.high, constants.x96);
+    const uint64_t upper32 = high_part.high ^ (accumulator.low >> 32U);
+    const uint64_t lower64 = high_part.low ^ (accumulator.low << 32U);
+    const uint64_t reduced64 = CarrylessMultiply(upper32, constants.x64).low ^ lower64;
+    // ... then Barrett-reduce the 64-bit remainder to 32 bits
+    const uint64_t quotient = CarrylessMultiply(reduced64 >> 32U, constants.mu).low >> 32U;
+    return static_cast<uint32_t>(reduced64 ^ CarrylessMultiply(quotient, constants.polynomial).low);
+}
+#endif
+}  // namespace
+
+void Crc16Update(Crc16Context& context, const etl::span<const uint8_t>& data) {
+    uint16_t crc = context.remainder;
+    const uint8_t* bytes = data.data();
+    size_t length = data.size();
+#ifdef SPIOPEN_FRAME_CLMUL_AVAILABLE
+    if (length >= fold_block_size) {
+        const uint32_t scaled_crc = static_cast<uint32_t>(crc) << 16U;
+        crc = static_cast<uint16_t>(FoldBlocks(scaled_crc, bytes, length, crc16_fold_constants) >> 16U);
+    }
+#endif
+    context.remainder = slicing::UpdateCrc<uint16_t, crc_slices>(crc, bytes, length, crc16_tables);
+}
+
+void Crc32Update(Crc32Context& context, const etl::span<const uint8_t>& data) {
+    uint32_t crc = context.remainder;
+    const uint8_t* bytes = data.data();
+    size_t length = data.size();
+#ifdef SPIOPEN_FRAME_CLMUL_AVAILABLE
+    if (length >= fold_block_size) {
+        crc = FoldBlocks(crc, bytes, length, crc32_fold_constants);
+    }
+#endif
+    context.remainder = slicing::UpdateCrc<uint32_t, crc_slices>(crc, bytes, length, crc32_tables);
+}
+
+uint16_t ComputeCrc16(const etl::span<const uint8_t>& data) {
+    Crc16Context context = Crc16Init();
+    Crc16Update(context, data);
+    return Crc16Finalize(context);
+}
+
+uint32_t ComputeCrc32(const etl::span<const uint8_t>& data) {
+    Crc32Context context = Crc32Init();
+    Crc32Update(context, data);
+    return Crc32Finalize(context);
+}
+
+uint16_t Secded16Encode11(const uint16_t raw11) { return software::Secded16Encode11(raw11); }
+
+Secded16DecodeResult Secded16Decode11(uint16_t encoded16) { return software::Secded16Decode11(encoded16); }
+
+}  // namespace spiopen::algorithms
@@ -0,0 +1,96 @@
+/*
+SpIOpen Frame Algorithm Helpers : Slicing-by-N CRC
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+
+Table-driven CRC for the non-reflected, MSB-first CRCs used by SpIOpen (CRC-16-CCITT and CRC-32/MPEG-2). The
+tables are generated at compile time. Table n holds the CRC contribution of a byte followed by n zero bytes, so N input
+bytes can be folded into the CRC with N independent lookups per iteration instead of N dependent ones. With a single
+table this is the classic byte-wise algorithm.
+Only included by algorithm implementation translation units (see AlgorithmBackend.md).
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "spiopen_frame_algorithms.h"
+
+namespace spiopen::algorithms::slicing {
+
+static constexpr uint16_t crc16_polynomial = CRC16_POLYNOMIAL;
+static constexpr uint32_t crc32_polynomial = CRC32_POLYNOMIAL;
+
+template <typename TCrc, size_t Slices>
+using CrcTables = std::array<std::array<TCrc, 256U>, Slices>;
+
+/**
+ * @brief Generate the slicing tables for a non-reflected CRC of width sizeof(TCrc) * 8.
+ */
+template <typename TCrc, TCrc Polynomial, size_t Slices>
+constexpr CrcTables<TCrc, Slices> MakeCrcTables() {
+    constexpr size_t width_bits = sizeof(TCrc) * 8U;
+    constexpr TCrc top_bit = static_cast<TCrc>(static_cast<TCrc>(1U) << (width_bits - 1U));
+    CrcTables<TCrc, Slices> tables{};
+    for (size_t byte = 0U; byte < 256U; ++byte) {
+        TCrc crc = static_cast<TCrc>(static_cast<TCrc>(byte) << (width_bits - 8U));
+        for (size_t bit = 0U; bit < 8U; ++bit) {
+            crc = ((crc & top_bit) != 0U) ? static_cast<TCrc>((crc << 1U) ^ Polynomial) : static_cast<TCrc>(crc << 1U);
+        }
+        tables[0][byte] = crc;
+    }
+    for (size_t slice = 1U; slice < Slices; ++slice) {
+        for (size_t byte = 0U; byte < 256U; ++byte) {
+            const TCrc previous = tables[slice - 1U][byte];
+            tables[slice][byte] =
+                static_cast<TCrc>(static_cast<TCrc>(previous << 8U) ^ tables[0][previous >> (width_bits - 8U)]);
+        }
+    }
+    return tables;
+}
+
+/**
+ * @brief Fold a single byte into a running CRC register using the first table.
+ */
+template <typename TCrc, size_t Slices>
+inline TCrc UpdateCrcByte(const TCrc crc, const uint8_t byte, const CrcTables<TCrc, Slices>& tables) {
+    constexpr size_t width_bits = sizeof(TCrc) * 8U;
+    return static_cast<TCrc>(static_cast<TCrc>(crc << 8U) ^
+                             tables[0][static_cast<uint8_t>((crc >> (width_bits - 8U)) ^ byte)]);
+}
+
+/**
+ * @brief Fold a block of bytes into a running CRC register, Slices bytes per iteration.
+ * @param crc Current CRC register (the initial value for a new computation)
+ * @return The updated CRC register
+ */
+template <typename TCrc, size_t Slices>
+inline TCrc UpdateCrc(TCrc crc, const uint8_t* data, size_t length, const CrcTables<TCrc, Slices>& tables) {
+    constexpr size_t width_bytes = sizeof(TCrc);
+
+    if constexpr (Slices >= width_bytes) {  // with fewer slices than CRC bytes this is the plain byte-wise algorithm
+        while (length >= Slices) {
+            TCrc next = 0U;
+            for (size_t i = 0U; i < Slices; ++i) {  // constant trip count, unrolled by the compiler
+                uint8_t byte = data[i];
+                if (i < width_bytes) {  // the CRC register overlaps the first bytes of the block
+                    byte ^= static_cast<uint8_t>(crc >> (8U * (width_bytes - 1U - i)));
+                }
+                next ^= tables[Slices - 1U - i][byte];
+            }
+            crc = next;
+            data += Slices;
+            length -= Slices;
+        }
+    }
+    while (length > 0U) {
+        crc = UpdateCrcByte(crc, *data, tables);
+        ++data;
+        --length;
+    }
+    return crc;
+}
+
+}  // namespace spiopen::algorithms::slicing
@@ -0,0 +1,160 @@
+/*
+SpIOpen Frame Algorithm Helpers : Software SECDED(16,11)
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+
+Pure-software SECDED(16,11) shared by the bundled algorithm backends. Only included by algorithm implementation
+translation units; each backend forwards its facade functions to these (see AlgorithmBackend.md). The bitwise
+variant is used unless CONFIG_SPIOPEN_FRAME_SECDED_LOOKUP_TABLES selects the compile-time generated lookup tables.
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "spiopen_frame_algorithms.h"
+#include "spiopen_frame_format.h"
+
+namespace spiopen::algorithms::software {
+
+// #TODO: use more etl::binary functionality to repalce a lot of these bitwise operations
+
+// use constants to trade memory for speed; the code and its parity masks are defined in spiopen_frame_format.h
+static constexpr uint16_t secded16_num_data_bits = format::SECDED16_NUM_DATA_BITS;
+static constexpr uint16_t secded16_num_parity_bits = format::SECDED16_NUM_PARITY_BITS;
+static constexpr uint16_t secded16_data_bit_mask = format::SECDED16_DATA_BIT_MASK;
+static constexpr std::array<uint16_t, 5> secded16_parity_bit_position_masks = {
+    1U << (secded16_num_data_bits + 0U), 1U << (secded16_num_data_bits + 1U), 1U << (secded16_num_data_bits + 2U),
+    1U << (secded16_num_data_bits + 3U), 1U << (secded16_num_data_bits + 4U)};
+static constexpr uint16_t secded16_syndrome_mask =
+    secded16_parity_bit_position_masks[0] | secded16_parity_bit_position_masks[1] |
+    secded16_parity_bit_position_masks[2] | secded16_parity_bit_position_masks[3];
+static constexpr uint16_t secded16_overall_parity_mask = secded16_parity_bit_position_masks[4];
+static constexpr uint8_t secded16_syndrome_to_data_bit_mapping[secded16_num_data_bits + secded16_num_parity_bits] = {
+    11U, 12U, 0U, 13U, 1U, 2U, 3U, 14U, 4U, 5U, 6U, 7U, 8U, 9U, 10U};  // 0-based indices
+
+// SECDED(16,11) systematic encoding, shared with the compile-time encoding of fixed frame shapes
+using format::Secded16Encode11Bitwise;
+
+// SECDED(16,11) systematic decoding
+// The data bits are placed in the least significant positions
+// in the encoded word. Hamming parity bits are palced at bit positions 12-15, and the overall parity bit is placed at
+// bit position 16. Bit number 1 is the least significant.
+inline Secded16DecodeResult Secded16Decode11Bitwise(uint16_t encoded16) {
+    Secded16DecodeResult result{};
+    result.data11 = encoded16 & secded16_data_bit_mask;
+    result.corrected = false;
+    result.uncorrectable = false;
+    uint16_t reencoded16 = Secded16Encode11Bitwise(result.data11);
+    if (encoded16 == reencoded16) {
+        return result;
+    }
+
+    if (__builtin_popcount(encoded16) % 2U !=
+        0) {  // overall parity is incorrect so there must be an odd number of errors
+        // Assume there is exactly one error and correct it using the syndrome.
+        uint16_t syndrome = (encoded16 ^ reencoded16) & secded16_syndrome_mask;
+        if (syndrome != 0U) {  // syndrome is non-zero, so we have a single-bit error in the data or syndrome bits
+            syndrome >>=
+                secded16_num_data_bits;  // syndrome now points to the 1-based data bit in the interleaved
+                                         // secded method which needs to be corrected. Use a lookup table to account for
+                                         // the difference between bit positions in the interleaved method (easy
+                                         // correciton math) and the systematic method (used on the wire)
+            size_t error_bit_position = secded16_syndrome_to_data_bit_mapping[syndrome - 1U];  // 0 based index
+            result.corrected = true;
+            result.data11 = (encoded16 ^ (1U << error_bit_position)) & secded16_data_bit_mask;
+        } else {  // syndrome is zero, so the overall parity is the only error. Don't bother correcting it because we
+                  // don't even return it.
+            result.corrected = true;
+        }
+    } else {  // overall parity is correct but the syndrome doesn't match, so there must be an even number of errors
+        result.uncorrectable = true;  // even numbers of errors, even two, are not correctable
+    }
+
+    return result;
+}
+
+// Lookup table variant (CONFIG_SPIOPEN_FRAME_SECDED_LOOKUP_TABLES): every 11-bit value is encoded at compile time,
+// so encoding is a single load. Decoding re-encodes the received data bits with the same table; the XOR of the received
+// and recomputed parity bits is a 5-bit syndrome that alone decides the outcome (the parity of the received word equals
+// the parity of the syndrome), so a 32-entry table holds the data correction and result flags for every syndrome.
+static constexpr size_t secded16_num_data_words = static_cast<size_t>(1U) << secded16_num_data_bits;
+static constexpr size_t secded16_num_syndromes = static_cast<size_t>(1U) << secded16_num_parity_bits;
+static constexpr size_t secded16_hamming_syndrome_mask = (secded16_num_syndromes / 2U) - 1U;
+
+struct Secded16SyndromeEntry {
+    uint16_t data_correction_mask;  // XOR into the received data bits to correct a single-bit data error
+    bool corrected;
+    bool uncorrectable;
+};
+
+constexpr std::array<uint16_t, secded16_num_data_words> MakeSecded16EncodeTable() {
+    std::array<uint16_t, secded16_num_data_words> table{};
+    for (size_t raw11 = 0U; raw11 < secded16_num_data_words; ++raw11) {
+        table[raw11] = Secded16Encode11Bitwise(static_cast<uint16_t>(raw11));
+    }
+    return table;
+}
+
+constexpr std::array<Secded16SyndromeEntry, secded16_num_syndromes> MakeSecded16SyndromeTable() {
+    std::array<Secded16SyndromeEntry, secded16_num_syndromes> table{};
+    for (size_t syndrome = 1U; syndrome < secded16_num_syndromes; ++syndrome) {
+        if ((__builtin_popcount(static_cast<unsigned int>(syndrome)) & 1U) == 0U) {
+            table[syndrome].uncorrectable = true;  // even number of errors
+            continue;
+        }
+        table[syndrome].corrected = true;
+        const size_t hamming_syndrome = syndrome & secded16_hamming_syndrome_mask;
+        if (hamming_syndrome != 0U) {  // zero means only the overall parity bit flipped
+            const size_t error_bit_position = secded16_syndrome_to_data_bit_mapping[hamming_syndrome - 1U];
+            table[syndrome].data_correction_mask =
+                static_cast<uint16_t>((1U << error_bit_position) & secded16_data_bit_mask);
+        }
+    }
+    return table;
+}
+
+static constexpr std::array<uint16_t, secded16_num_data_words> secded16_encode_table = MakeSecded16EncodeTable();
+static constexpr std::array<Secded16SyndromeEntry, secded16_num_syndromes> secded16_syndrome_table =
+    MakeSecded16SyndromeTable();
+
+inline uint16_t Secded16Encode11Lookup(const uint16_t raw11) {
+    return secded16_encode_table[raw11 & secded16_data_bit_mask];
+}
+
+inline Secded16DecodeResult Secded16Decode11Lookup(uint16_t encoded16) {
+    Secded16DecodeResult result{};
+    result.data11 = encoded16 & secded16_data_bit_mask;
+    result.corrected = false;
+    result.uncorrectable = false;
+    const uint16_t syndrome = static_cast<uint16_t>(encoded16 ^ secded16_encode_table[result.data11]) >>
+                              secded16_num_data_bits;
+    if (syndrome == 0U) {  // fast path: no errors
+        return result;
+    }
+    const Secded16SyndromeEntry& entry = secded16_syndrome_table[syndrome];
+    result.data11 ^= entry.data_correction_mask;
+    result.corrected = entry.corrected;
+    result.uncorrectable = entry.uncorrectable;
+    return result;
+}
+
+inline uint16_t Secded16Encode11(const uint16_t raw11) {
+#ifdef CONFIG_SPIOPEN_FRAME_SECDED_LOOKUP_TABLES
+    return Secded16Encode11Lookup(raw11);
+#else
+    return Secded16Encode11Bitwise(raw11);
+#endif
+}
+
+inline Secded16DecodeResult Secded16Decode11(uint16_t encoded16) {
+#ifdef CONFIG_SPIOPEN_FRAME_SECDED_LOOKUP_TABLES
+    return Secded16Decode11Lookup(encoded16);
+#else
+    return Secded16Decode11Bitwise(encoded16);
+#endif
+}
+
+}  // namespace spiopen::algorithms::software
@@ -0,0 +1,60 @@
+/*
+SpIOpen Frame Algorithm Implementation (Slicing-by-N / Software)
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+
+Portable table-driven implementation. CRCs are computed N bytes at a time with compile-time generated slicing tables
+(N = 8 by default, 4 with CONFIG_SPIOPEN_FRAME_CRC_SLICING_BY_4), trading flash for throughput on long FD/XL frames:
+8 slices cost 12KB of tables, 4 slices cost 6KB. SECDED is the shared software implementation.
+Select it by pointing SPIOPEN_FRAME_ALGORITHM_SOURCE at this file (see AlgorithmBackend.md).
+*/
+
+#include "spiopen_frame_algorithms.h"
+
+#include "../common/spiopen_frame_crc_slicing.h"
+#include "../common/spiopen_frame_secded_software.h"
+#include "etl/span.h"
+
+namespace spiopen::algorithms {
+
+namespace {
+#ifdef CONFIG_SPIOPEN_FRAME_CRC_SLICING_BY_4
+constexpr size_t crc_slices = 4U;
+#else
+constexpr size_t crc_slices = 8U;
+#endif
+
+constexpr slicing::CrcTables<uint16_t, crc_slices> crc16_tables =
+    slicing::MakeCrcTables<uint16_t, slicing::crc16_polynomial, crc_slices>();
+constexpr slicing::CrcTables<uint32_t, crc_slices> crc32_tables =
+    slicing::MakeCrcTables<uint32_t, slicing::crc32_polynomial, crc_slices>();
+}  // namespace
+
+void Crc16Update(Crc16Context& context, const etl::span<const uint8_t>& data) {
+    context.remainder =
+        slicing::UpdateCrc<uint16_t, crc_slices>(context.remainder, data.data(), data.size(), crc16_tables);
+}
+
+void Crc32Update(Crc32Context& context, const etl::span<const uint8_t>& data) {
+    context.remainder =
+        slicing::UpdateCrc<uint32_t, crc_slices>(context.remainder, data.data(), data.size(), crc32_tables);
+}
+
+uint16_t ComputeCrc16(const etl::span<const uint8_t>& data) {
+    Crc16Context context = Crc16Init();
+    Crc16Update(context, data);
+    return Crc16Finalize(context);
+}
+
+uint32_t ComputeCrc32(const etl::span<const uint8_t>& data) {
+    Crc32Context context = Crc32Init();
+    Crc32Update(context, data);
+    return Crc32Finalize(context);
+}
+
+uint16_t Secded16Encode11(const uint16_t raw11) { return software::Secded16Encode11(raw11); }
+
+Secded16DecodeResult Secded16Decode11(uint16_t encoded16) { return software::Secded16Decode11(encoded16); }
+
+}  // namespace spiopen::algorithms
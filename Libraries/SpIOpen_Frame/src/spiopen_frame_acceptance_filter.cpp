@@ -0,0 +1,74 @@
+/*
+SpIOpen Frame Acceptance Filter : Implementation
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+*/
+
+#include "spiopen_frame_acceptance_filter.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace spiopen::frame_reader {
+
+void AcceptanceFilter::Clear() {
+    standard_ids_.fill(0U);
+    extended_ids_.fill(EMPTY_SLOT);
+    extended_id_count_ = 0U;
+    masks_.fill(MaskFilter{0U, 0U, false});
+    mask_count_ = 0U;
+}
+
+bool AcceptanceFilter::AddExtendedId(const uint32_t can_identifier) {
+    const uint32_t id = can_identifier & EXTENDED_ID_MASK;
+    size_t slot = GetExtendedIdSlot(id);
+    while (extended_ids_[slot] != EMPTY_SLOT) {
+        if (extended_ids_[slot] == id) {
+            return true;
+        }
+        slot = (slot + 1U) & (EXTENDED_ID_SLOTS - 1U);
+    }
+    if (extended_id_count_ == MAX_EXTENDED_IDS) {
+        return false;
+    }
+    extended_ids_[slot] = id;
+    ++extended_id_count_;
+    return true;
+}
+
+bool AcceptanceFilter::AddMask(const uint32_t code, const uint32_t mask, const bool extended) {
+    if (mask_count_ == MAX_MASK_FILTERS) {
+        return false;
+    }
+    const uint32_t id_mask = extended ? EXTENDED_ID_MASK : STANDARD_ID_MASK;
+    masks_[mask_count_++] = MaskFilter{code & mask & id_mask, mask & id_mask, extended};
+    return true;
+}
+
+bool AcceptanceFilter::Accepts(const uint32_t can_identifier, const bool extended) const {
+    if (extended) {
+        const uint32_t id = can_identifier & EXTENDED_ID_MASK;
+        // the table is never full, so the probe always ends at an empty slot
+        for (size_t slot = GetExtendedIdSlot(id); extended_ids_[slot] != EMPTY_SLOT;
+             slot = (slot + 1U) & (EXTENDED_ID_SLOTS - 1U)) {
+            if (extended_ids_[slot] == id) {
+                return true;
+            }
+        }
+    } else {
+        const uint32_t id = can_identifier & STANDARD_ID_MASK;
+        if ((standard_ids_[id >> 5U] & (static_cast<uint32_t>(1U) << (id & 0x1FU))) != 0U) {
+            return true;
+        }
+    }
+    for (size_t i = 0U; i < mask_count_; ++i) {
+        const MaskFilter& filter = masks_[i];
+        if ((filter.extended == extended) && ((can_identifier & filter.mask) == filter.code)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+}  // namespace spiopen::frame_reader
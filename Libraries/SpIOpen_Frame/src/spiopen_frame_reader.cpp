@@ -16,13 +16,350 @@ SPDX-License-Identifier: Apache-2.0
 #include <cstring>
 
 #include "spiopen_frame_algorithms.h"
+#include "spiopen_frame_statistics.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SPIOPEN_FRAME_READER_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define SPIOPEN_FRAME_READER_SSE2 1
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define SPIOPEN_FRAME_READER_NEON 1
+#endif
 
 namespace spiopen::frame_reader {
 
 using namespace spiopen::format;
 
+namespace {
+
+// Block matchers for the preamble scans. Each returns a mask with scan_bits_per_byte bits set for every matching byte
+// of the block, in buffer order starting at the least significant bit, so the first match is a count of trailing
+// zeros away.
+#if defined(SPIOPEN_FRAME_READER_AVX2)
+#define SPIOPEN_FRAME_READER_SIMD 1
+constexpr size_t scan_block_size = 32U;
+constexpr size_t scan_bits_per_byte = 1U;
+
+inline uint64_t MatchPreambleBytes(const uint8_t* block, const bool include_complement) {
+    const __m256i bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+    __m256i matches = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(static_cast<char>(PREAMBLE_BYTE)));
+    if (include_complement) {
+        const __m256i complement = _mm256_set1_epi8(static_cast<char>(PREAMBLE_BYTE_COMPLEMENT));
+        matches = _mm256_or_si256(matches, _mm256_cmpeq_epi8(bytes, complement));
+    }
+    return static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+}
+
+// reads scan_block_size + 1 bytes
+inline uint64_t MatchPreambleWords(const uint8_t* block) {
+    const __m256i preamble = _mm256_set1_epi8(static_cast<char>(PREAMBLE_BYTE));
+    const __m256i first = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block)), preamble);
+    const __m256i second =
+        _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 1U)), preamble);
+    return static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(first, second)));
+}
+#elif defined(SPIOPEN_FRAME_READER_SSE2)
+#define SPIOPEN_FRAME_READER_SIMD 1
+constexpr size_t scan_block_size = 16U;
+constexpr size_t scan_bits_per_byte = 1U;
+
+inline uint64_t MatchPreambleBytes(const uint8_t* block, const bool include_complement) {
+    const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+    __m128i matches = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(PREAMBLE_BYTE)));
+    if (include_complement) {
+        matches =
+            _mm_or_si128(matches, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(static_cast<char>(PREAMBLE_BYTE_COMPLEMENT))));
+    }
+    return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+}
+
+// reads scan_block_size + 1 bytes
+inline uint64_t MatchPreambleWords(const uint8_t* block) {
+    const __m128i preamble = _mm_set1_epi8(static_cast<char>(PREAMBLE_BYTE));
+    const __m128i first = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block)), preamble);
+    const __m128i second = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 1U)), preamble);
+    return static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(first, second)));
+}
+#elif defined(SPIOPEN_FRAME_READER_NEON)
+#define SPIOPEN_FRAME_READER_SIMD 1
+constexpr size_t scan_block_size = 16U;
+constexpr size_t scan_bits_per_byte = 4U;
+
+// NEON has no movemask: narrowing each 16-bit lane by 4 bits leaves one nibble per byte
+inline uint64_t NibbleMask(const uint8x16_t matches) {
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+}
+
+inline uint64_t MatchPreambleBytes(const uint8_t* block, const bool include_complement) {
+    const uint8x16_t bytes = vld1q_u8(block);
+    uint8x16_t matches = vceqq_u8(bytes, vdupq_n_u8(PREAMBLE_BYTE));
+    if (include_complement) {
+        matches = vorrq_u8(matches, vceqq_u8(bytes, vdupq_n_u8(PREAMBLE_BYTE_COMPLEMENT)));
+    }
+    return NibbleMask(matches);
+}
+
+// reads scan_block_size + 1 bytes
+inline uint64_t MatchPreambleWords(const uint8_t* block) {
+    const uint8x16_t preamble = vdupq_n_u8(PREAMBLE_BYTE);
+    return NibbleMask(vandq_u8(vceqq_u8(vld1q_u8(block), preamble), vceqq_u8(vld1q_u8(block + 1U), preamble)));
+}
+#else
+constexpr size_t scan_block_size = sizeof(uint64_t);
+constexpr size_t scan_bits_per_byte = 1U;
+
+// Word-at-a-time fallback: a word only needs a byte-wise look if one of its bytes equals the pattern
+inline bool WordHasByte(const uint64_t word, const uint8_t pattern) {
+    constexpr uint64_t ones = 0x0101010101010101ULL;
+    constexpr uint64_t highs = 0x8080808080808080ULL;
+    const uint64_t difference = word ^ (ones * pattern);
+    return ((difference - ones) & ~difference & highs) != 0U;
+}
+
+inline uint64_t MatchPreambleBytes(const uint8_t* block, const bool include_complement) {
+    uint64_t word;
+    memcpy(&word, block, sizeof(word));
+    if (!WordHasByte(word, PREAMBLE_BYTE) && !(include_complement && WordHasByte(word, PREAMBLE_BYTE_COMPLEMENT))) {
+        return 0U;
+    }
+    uint64_t matches = 0U;
+    for (size_t i = 0U; i < scan_block_size; ++i) {
+        if ((block[i] == PREAMBLE_BYTE) || (include_complement && (block[i] == PREAMBLE_BYTE_COMPLEMENT))) {
+            matches |= 1ULL << i;
+        }
+    }
+    return matches;
+}
+#endif
+
+inline size_t FirstMatch(const uint64_t matches) {
+    return static_cast<size_t>(__builtin_ctzll(matches)) / scan_bits_per_byte;
+}
+
+/**
+ * @brief Walks the preamble byte candidates (and optionally complement candidates) of a buffer in order.
+ *
+ * Every byte is compared exactly once: the match mask of the current block is kept and consumed one candidate at a
+ * time, so visiting all candidates is O(n) however dense or sparse they are. The last partial block is compared from
+ * a zero-padded copy, zero never being a candidate.
+ */
+class PreambleCandidateCursor {
+   public:
+    PreambleCandidateCursor(const etl::span<const uint8_t>& buffer, size_t offset, bool include_complement)
+        : data_(buffer.data()),
+          length_(buffer.size()),
+          block_start_(offset),
+          matches_(0U),
+          include_complement_(include_complement) {
+        LoadBlock();
+    }
+
+    /**
+     * @brief Advance to the next candidate
+     * @return Offset of the next candidate from the start of the buffer, or the buffer size if there are no more
+     */
+    size_t Next() {
+        while (matches_ == 0U) {
+            block_start_ += scan_block_size;
+            if (block_start_ >= length_) {
+                block_start_ = length_;
+                return length_;
+            }
+            LoadBlock();
+        }
+        const size_t byte_in_block = FirstMatch(matches_);
+        matches_ &= ~(((1ULL << scan_bits_per_byte) - 1U) << (byte_in_block * scan_bits_per_byte));
+        return block_start_ + byte_in_block;
+    }
+
+   private:
+    void LoadBlock() {
+        if (block_start_ >= length_) {
+            matches_ = 0U;
+        } else if (block_start_ + scan_block_size <= length_) {
+            matches_ = MatchPreambleBytes(data_ + block_start_, include_complement_);
+        } else {
+            uint8_t tail[scan_block_size] = {0};
+            memcpy(tail, data_ + block_start_, length_ - block_start_);
+            matches_ = MatchPreambleBytes(tail, include_complement_);
+        }
+    }
+
+    const uint8_t* data_;
+    size_t length_;
+    size_t block_start_;
+    uint64_t matches_;
+    bool include_complement_;
+};
+
+// A preamble received with s bits of slip (1 to 7) starts s bits into the byte before a candidate byte, which holds the
+// middle 8 bits of the pattern (0xAA for even slips, 0x55 for odd ones), and ends s bits into the byte after it. With
+// no slip the candidate is the first preamble byte and the byte after it the second. Bit s of a table entry is set if
+// the byte fits a preamble with s bits of slip in that position, so the slips that fit all three bytes of a window are
+// the AND of three lookups.
+struct PreambleSlipTables {
+    uint8_t previous[256];
+    uint8_t next[256];
+};
+
+constexpr uint16_t preamble_pattern = (static_cast<uint16_t>(PREAMBLE_BYTE) << 8U) | PREAMBLE_BYTE;
+constexpr uint8_t even_slips = 0x55U;  // slips 0, 2, 4, 6
+constexpr uint8_t odd_slips = 0xAAU;   // slips 1, 3, 5, 7
+
+constexpr PreambleSlipTables MakePreambleSlipTables() {
+    PreambleSlipTables tables{};
+    for (uint16_t byte = 0U; byte < 256U; ++byte) {
+        uint8_t previous = 0x01U;  // no slip: the byte before the preamble is not part of it
+        uint8_t next = (byte == PREAMBLE_BYTE) ? 0x01U : 0x00U;
+        for (uint8_t slip = 1U; slip < 8U; ++slip) {
+            const uint8_t previous_bits = static_cast<uint8_t>(8U - slip);  // low bits of the byte before
+            const uint16_t previous_mask = static_cast<uint16_t>((1U << previous_bits) - 1U);
+            if ((byte & previous_mask) == ((preamble_pattern >> (8U + slip)) & previous_mask)) {
+                previous |= static_cast<uint8_t>(1U << slip);
+            }
+            // high bits of the byte after
+            if (static_cast<uint16_t>(byte >> previous_bits) == (preamble_pattern & ((1U << slip) - 1U))) {
+                next |= static_cast<uint8_t>(1U << slip);
+            }
+        }
+        tables.previous[byte] = previous;
+        tables.next[byte] = next;
+    }
+    return tables;
+}
+
+constexpr PreambleSlipTables preamble_slip_tables = MakePreambleSlipTables();
+
+/**
+ * @brief Pick the bit slip of the earliest preamble from a mask of slips that fit a window
+ * @param slips Mask from MatchPreambleSlips, must be non-zero
+ * @return The smallest non-zero slip (a preamble starting in the byte before the candidate), or 0 if only the aligned
+ * preamble at the candidate fits
+ */
+inline uint8_t EarliestPreambleSlip(const uint8_t slips) {
+    const uint8_t slipped = static_cast<uint8_t>(slips & 0xFEU);
+    return (slipped != 0U) ? static_cast<uint8_t>(__builtin_ctz(slipped)) : 0U;
+}
+
+// Realign bit-slipped data: every output byte is the source byte shifted left by the slip, with the high bits of the
+// following source byte shifted in, so count output bytes take count + 1 source bytes. The vector step shifts 16-bit
+// lanes of the block and of the block one byte later, masking off the bits that crossed a byte boundary.
+#if defined(SPIOPEN_FRAME_READER_AVX2)
+constexpr size_t realign_block_size = 32U;
+
+inline void RealignBlock(const uint8_t* source, uint8_t* dest, const uint8_t bit_slip_count) {
+    const __m128i high_shift = _mm_cvtsi32_si128(bit_slip_count);
+    const __m128i low_shift = _mm_cvtsi32_si128(8 - bit_slip_count);
+    const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source));
+    const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + 1U));
+    const __m256i high_bits = _mm256_and_si256(_mm256_sll_epi16(high, high_shift),
+                                               _mm256_set1_epi8(static_cast<char>(0xFFU << bit_slip_count)));
+    const __m256i low_bits = _mm256_and_si256(_mm256_srl_epi16(low, low_shift),
+                                              _mm256_set1_epi8(static_cast<char>(0xFFU >> (8U - bit_slip_count))));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest), _mm256_or_si256(high_bits, low_bits));
+}
+#elif defined(SPIOPEN_FRAME_READER_SSE2)
+constexpr size_t realign_block_size = 16U;
+
+inline void RealignBlock(const uint8_t* source, uint8_t* dest, const uint8_t bit_slip_count) {
+    const __m128i high_shift = _mm_cvtsi32_si128(bit_slip_count);
+    const __m128i low_shift = _mm_cvtsi32_si128(8 - bit_slip_count);
+    const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source));
+    const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + 1U));
+    const __m128i high_bits =
+        _mm_and_si128(_mm_sll_epi16(high, high_shift), _mm_set1_epi8(static_cast<char>(0xFFU << bit_slip_count)));
+    const __m128i low_bits =
+        _mm_and_si128(_mm_srl_epi16(low, low_shift), _mm_set1_epi8(static_cast<char>(0xFFU >> (8U - bit_slip_count))));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dest), _mm_or_si128(high_bits, low_bits));
+}
+#elif defined(SPIOPEN_FRAME_READER_NEON)
+constexpr size_t realign_block_size = 16U;
+
+inline void RealignBlock(const uint8_t* source, uint8_t* dest, const uint8_t bit_slip_count) {
+    // NEON shifts each byte lane on its own; a negative count shifts right
+    const uint8x16_t high_bits = vshlq_u8(vld1q_u8(source), vdupq_n_s8(static_cast<int8_t>(bit_slip_count)));
+    const uint8x16_t low_bits = vshlq_u8(vld1q_u8(source + 1U), vdupq_n_s8(static_cast<int8_t>(bit_slip_count - 8)));
+    vst1q_u8(dest, vorrq_u8(high_bits, low_bits));
+}
+#else
+// 64-bit funnel shift: 8 output bytes from a big-endian word and the first bits of the byte after it
+constexpr size_t realign_block_size = sizeof(uint64_t);
+
+inline uint64_t LoadBigEndian64(const uint8_t* source) {
+    uint64_t word;
+    memcpy(&word, source, sizeof(word));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    word = __builtin_bswap64(word);
+#endif
+    return word;
+}
+
+inline void RealignBlock(const uint8_t* source, uint8_t* dest, const uint8_t bit_slip_count) {
+    uint64_t word = (LoadBigEndian64(source) << bit_slip_count) | (source[sizeof(uint64_t)] >> (8U - bit_slip_count));
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    word = __builtin_bswap64(word);
+#endif
+    memcpy(dest, &word, sizeof(word));
+}
+#endif
+
+// Byte of a frame prefix at index once realigned for the bit slip
+inline uint8_t RealignedByte(const uint8_t* prefix, const size_t index, const uint8_t bit_slip_count) {
+    if (bit_slip_count == 0U) {
+        return prefix[index];
+    }
+    return static_cast<uint8_t>((static_cast<uint16_t>(prefix[index]) << bit_slip_count) |
+                                (prefix[index + 1U] >> (8U - bit_slip_count)));
+}
+
+}  // namespace
+
 namespace impl {
 
+// Reject frame types that support was not built in for
+etl::expected<void, FrameParseError> CheckFrameTypeEnabled(const Frame& frame) {
+#ifndef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
+    if (frame.can_flags.FDF) {
+        return etl::unexpected(FrameParseError::CanFdNotSupported);
+    }
+#endif
+#ifndef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    if (frame.can_flags.XLF) {
+        return etl::unexpected(FrameParseError::CanXlNotSupported);
+    }
+#endif
+    (void)frame;
+    return {};
+}
+
+// On-wire frame length from the decoded header flags and the payload section length, including padding
+size_t GetWireFrameLength(const Frame& header, const size_t payload_len) {
+    size_t frame_length = PREAMBLE_SIZE + header.GetHeaderLength() + payload_len +
+                          GetCrcLengthFromPayloadLength(payload_len);
+    return frame_length + GetAlignmentPaddingLength(frame_length, header.GetAlignment());
+}
+
+/**
+ * @brief Realign bytes_to_copy bytes of bit-slipped data
+ * @param source Slipped data, bytes_to_copy + 1 bytes are read
+ * @param dest Destination for bytes_to_copy realigned bytes, must not overlap source
+ * @param bytes_to_copy Number of bytes to write
+ * @param bit_slip_count Bit slip to correct for, 1 to 7
+ */
+void RealignBitSlipped(const uint8_t* source, uint8_t* dest, const size_t bytes_to_copy, const uint8_t bit_slip_count) {
+    size_t index = 0U;
+    for (; index + realign_block_size <= bytes_to_copy; index += realign_block_size) {
+        RealignBlock(source + index, dest + index, bit_slip_count);
+    }
+    for (; index < bytes_to_copy; ++index) {
+        dest[index] = static_cast<uint8_t>((static_cast<uint16_t>(source[index]) << bit_slip_count) |
+                                           (source[index + 1U] >> (8U - bit_slip_count)));
+    }
+}
+
 etl::expected<void, FrameParseError> ParseFormatHeader(const uint8_t high, const uint8_t low, Frame& frame,
                                                        bool& dlc_corrected, size_t& payload_len_out) {
     const uint16_t encoded_header = static_cast<uint16_t>((static_cast<uint16_t>(high) << 8U) | low);
@@ -39,6 +376,13 @@ etl::expected<void, FrameParseError> ParseFormatHeader(const uint8_t high, const
     frame.can_flags.XLF = (raw_header11 & static_cast<uint16_t>(HEADER_XLF_MASK)) != 0U;
     frame.can_flags.TTL = (raw_header11 & static_cast<uint16_t>(HEADER_TTL_MASK)) != 0U;
     frame.can_flags.WA = ((raw_header11 >> 8U) & HEADER_WA_MASK) != 0U;
+#ifdef CONFIG_SPIOPEN_FRAME_WIDE_ALIGNMENT_ENABLE
+    frame.can_flags.DWA = ((raw_header11 >> 8U) & HEADER_DWA_MASK) != 0U;
+#else
+    if (((raw_header11 >> 8U) & HEADER_DWA_MASK) != 0U) {
+        return etl::unexpected(FrameParseError::WideAlignmentNotSupported);
+    }
+#endif
 
     payload_len_out = GetPayloadLengthFromDlc(dlc_nibble);
     return {};
@@ -72,18 +416,7 @@ etl::expected<void, FrameParseError> ReadFormatHeader(etl::byte_stream_reader& s
     if (!parse_result) {
         return parse_result;
     }
-
-#ifndef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
-    if (out_frame.can_flags.FDF) {
-        return etl::unexpected(FrameParseError::CanFdNotSupported);
-    }
-#endif
-#ifndef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
-    if (out_frame.can_flags.XLF) {
-        return etl::unexpected(FrameParseError::CanXlNotSupported);
-    }
-#endif
-    return {};
+    return CheckFrameTypeEnabled(out_frame);
 }
 
 etl::expected<void, FrameParseError> ReadXlPayloadLength(etl::byte_stream_reader& stream, Frame& out_frame,
@@ -195,6 +528,28 @@ etl::expected<void, FrameParseError> ValidateCRC(etl::byte_stream_reader& stream
     return {};
 }
 
+// Compare the CRC stored at the stream position against a CRC that was accumulated while the frame was copied.
+etl::expected<void, FrameParseError> ValidateCRC(etl::byte_stream_reader& stream, const FrameCrc& computed_crc) {
+    if (computed_crc.IsLong()) {
+        auto received = stream.read<uint32_t>();
+        if (!received) {
+            return etl::unexpected(FrameParseError::BufferTooShortForPayload);
+        }
+        if (computed_crc.GetValue() != *received) {
+            return etl::unexpected(FrameParseError::CrcMismatch);
+        }
+    } else {
+        auto received = stream.read<uint16_t>();
+        if (!received) {
+            return etl::unexpected(FrameParseError::BufferTooShortForPayload);
+        }
+        if (computed_crc.GetValue() != static_cast<uint32_t>(*received)) {
+            return etl::unexpected(FrameParseError::CrcMismatch);
+        }
+    }
+    return {};
+}
+
 //#TODO: use the ETL::bi_stream_X functions to make this more clear, and maybe more efficient
 //@param bit_slip_count: positive for extra bits received (effectively a right shift of the data), to a maximum of 7. 0
 // indicates no bit slips
@@ -222,17 +577,38 @@ bool CopyFromBitSlippedBuffer(etl::byte_stream_reader& source, etl::byte_stream_
     if (source.available_bytes() <= bytes_to_copy) {
         return false;
     }
-    uint8_t high = source.read_unchecked<uint8_t>();  // this is the "extra" byte that we read
-    for (size_t i = 0U; i < bytes_to_copy; ++i) {
-        uint8_t low = source.read_unchecked<uint8_t>();
-        // correct for the effective right shift by left shifting the high byte back into alignment.
-        // Then right shift the low byte by the opposite amount so we can OR the two together to get the final byte.
-        const uint8_t out =
-            static_cast<uint8_t>((static_cast<uint16_t>(high) << bit_slip_count) | (low >> (8U - bit_slip_count)));
-        dest.write_unchecked(out);
-        high = low;
-    }
-    source.restart(source.used_data().size() - 1U);  // move back one byte so a subsequent call can read a partial byte.
+    // correct for the effective right shift by left shifting each byte back into alignment, with the high bits of the
+    // next ("extra") byte filling in the low bits
+    RealignBitSlipped(reinterpret_cast<const uint8_t*>(source.free_data().data()),
+                      reinterpret_cast<uint8_t*>(dest.free_data().data()), bytes_to_copy, bit_slip_count);
+    // the extra byte is left unread so a subsequent call can read its remaining bits
+    source.skip<uint8_t>(bytes_to_copy);
+    dest.skip<uint8_t>(bytes_to_copy);
+    return true;
+}
+
+// Single-pass copy and verify: realign the data in cache-sized chunks and fold each chunk into the CRC right after it
+// is written, so the frame is swept through memory once instead of once for the copy and once for the CRC.
+// Same preconditions, semantics and return value as the plain copy.
+bool CopyFromBitSlippedBuffer(etl::byte_stream_reader& source, etl::byte_stream_writer& dest, size_t bytes_to_copy,
+                              uint8_t bit_slip_count, FrameCrc& crc) {
+    static constexpr size_t crc_chunk_size = 64U;  // comfortably inside L1 on every target with a data cache
+
+    // check everything up front so a short buffer fails before any of the frame is copied, like the plain copy
+    const size_t source_bytes_needed = (bit_slip_count == 0U) ? bytes_to_copy : bytes_to_copy + 1U;
+    if (bit_slip_count > 7U || dest.available_bytes() < bytes_to_copy ||
+        source.available_bytes() < source_bytes_needed) {
+        return false;
+    }
+    while (bytes_to_copy > 0U) {
+        const size_t chunk = (bytes_to_copy < crc_chunk_size) ? bytes_to_copy : crc_chunk_size;
+        const uint8_t* chunk_start = reinterpret_cast<const uint8_t*>(dest.free_data().data());
+        if (!CopyFromBitSlippedBuffer(source, dest, chunk, bit_slip_count)) {
+            return false;
+        }
+        crc.Add(etl::span<const uint8_t>(chunk_start, chunk));
+        bytes_to_copy -= chunk;
+    }
     return true;
 }
 
@@ -240,7 +616,41 @@ bool CopyFromBitSlippedBuffer(etl::byte_stream_reader& source, etl::byte_stream_
 
 using namespace impl;
 
-etl::expected<FrameReadResult, FrameParseError> ReadFrame(etl::byte_stream_reader& stream, Frame& out_frame) {
+namespace {
+
+// Count a read in the receive statistics. The public readers count; the functions below, which they (and ParseAll())
+// build on, do not, so a frame is only counted once.
+#ifdef CONFIG_SPIOPEN_FRAME_READER_STATISTICS
+void CountRead(const etl::expected<FrameReadResult, FrameParseError>& read, const Frame& frame,
+               const uint8_t bit_slip_count) {
+    if (!read) {
+        CountParseError(read.error());
+        return;
+    }
+    size_t frame_length = 0U;
+    if (frame.TryGetFrameLength(frame_length)) {
+        CountFrame(frame.can_flags, frame_length, read->dlc_corrected, bit_slip_count);
+    }
+}
+#else
+// Statistics disabled: nothing to count
+void CountRead(const etl::expected<FrameReadResult, FrameParseError>&, const Frame&, uint8_t) {}
+#endif
+
+// Skip the rest of a frame the acceptance filter rejected, bytes_read bytes in, leaving the stream where reading the
+// frame would have. A slipped frame needs the byte after it too, as when it is copied.
+FrameParseError SkipFilteredFrame(etl::byte_stream_reader& stream, const Frame& header, const size_t payload_len,
+                                  const size_t bytes_read, const uint8_t bit_slip_count) {
+    const size_t remaining = GetWireFrameLength(header, payload_len) - bytes_read;
+    if (stream.available_bytes() < remaining + ((bit_slip_count == 0U) ? 0U : 1U)) {
+        return FrameParseError::BufferTooShortForPayload;
+    }
+    stream.skip<uint8_t>(remaining);
+    return FrameParseError::FrameFiltered;
+}
+
+etl::expected<FrameReadResult, FrameParseError> ReadFrameUncounted(etl::byte_stream_reader& stream, Frame& out_frame,
+                                                                   const AcceptanceFilter* filter) {
     FrameReadResult result{};
     result.dlc_corrected = false;
 
@@ -277,6 +687,10 @@ etl::expected<FrameReadResult, FrameParseError> ReadFrame(etl::byte_stream_reade
     if (!cid) {
         return etl::unexpected(cid.error());
     }
+    if ((filter != nullptr) && !filter->Accepts(out_frame.can_identifier, out_frame.can_flags.IDE)) {
+        const size_t bytes_read = PREAMBLE_SIZE + stream.used_data().size() - start_position;
+        return etl::unexpected(SkipFilteredFrame(stream, out_frame, payload_len, bytes_read, 0U));
+    }
 
     if (out_frame.can_flags.TTL) {
         auto ttl = ReadTTL(stream, out_frame);
@@ -292,6 +706,14 @@ etl::expected<FrameReadResult, FrameParseError> ReadFrame(etl::byte_stream_reade
     // it comes out of the reader as a const span, so we need to cast it to a mutable span
     out_frame.payload = etl::span<uint8_t>(const_cast<uint8_t*>((*payload_data).data()), (*payload_data).size());
 
+    // the alignment padding sits between the payload and the CRC, and is covered by the CRC
+    const size_t padding_length = GetAlignmentPaddingLength(
+        PREAMBLE_SIZE + (stream.used_data().size() - start_position) + GetCrcLengthFromPayloadLength(payload_len),
+        out_frame.GetAlignment());
+    if ((padding_length > 0U) && !stream.skip<uint8_t>(padding_length)) {
+        return etl::unexpected(FrameParseError::BufferTooShortForPayload);
+    }
+
     auto crc_region = stream.used_data().subspan(start_position);  // start position is marked after preamble
     auto crc =
         ValidateCRC(stream, out_frame,
@@ -303,9 +725,10 @@ etl::expected<FrameReadResult, FrameParseError> ReadFrame(etl::byte_stream_reade
     return result;
 }
 
-etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrame(etl::byte_stream_reader& input_stream,
-                                                                 etl::span<uint8_t> destination_buffer,
-                                                                 Frame& out_frame, uint8_t bit_slip_count) {
+etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrameUncounted(etl::byte_stream_reader& input_stream,
+                                                                          etl::span<uint8_t> destination_buffer,
+                                                                          Frame& out_frame, uint8_t bit_slip_count,
+                                                                          const AcceptanceFilter* filter) {
     FrameReadResult result{};
     result.dlc_corrected = false;
 
@@ -370,6 +793,10 @@ etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrame(etl::byte_strea
     if (!frame_parse_result) {
         return etl::unexpected(frame_parse_result.error());
     }
+    if ((filter != nullptr) && !filter->Accepts(out_frame.can_identifier, out_frame.can_flags.IDE)) {
+        return etl::unexpected(SkipFilteredFrame(input_stream, out_frame, payload_len,
+                                                 destination_stream_writer.size_bytes(), bit_slip_count));
+    }
 
     // ttl
     if (out_frame.can_flags.TTL) {
@@ -392,18 +819,23 @@ etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrame(etl::byte_strea
     if (!out_frame.TryGetFrameLength(frame_length)) {
         return etl::unexpected(FrameParseError::InvalidFrameLength);
     }
-    size_t remaining_bytes = frame_length - (PREAMBLE_SIZE + out_frame.GetHeaderLength());
-    // copy the rest of the frame
-    if (!CopyFromBitSlippedBuffer(input_stream, destination_stream_writer, remaining_bytes, bit_slip_count)) {
+
+    // the header is already in the destination (and in cache): start the CRC with it, then fold the payload and
+    // padding in while they are realigned, so the payload is only touched once
+    const size_t header_end = PREAMBLE_SIZE + out_frame.GetHeaderLength();
+    FrameCrc crc(payload_len);
+    crc.Add(etl::span<const uint8_t>(destination_buffer.data() + PREAMBLE_SIZE, header_end - PREAMBLE_SIZE));
+    const size_t crc_region_end = frame_length - crc.GetSize();
+    if (!CopyFromBitSlippedBuffer(input_stream, destination_stream_writer, crc_region_end - header_end, bit_slip_count,
+                                  crc)) {
         return etl::unexpected(FrameParseError::BufferTooShortForPayload);
     }
-    destination_stream_reader.restart(frame_length -
-                                      GetCrcLengthFromPayloadLength(payload_len));  // set up to read the crc
-    auto crc_region = destination_stream_reader.used_data().subspan(PREAMBLE_SIZE);
+    if (!CopyFromBitSlippedBuffer(input_stream, destination_stream_writer, crc.GetSize(), bit_slip_count)) {
+        return etl::unexpected(FrameParseError::BufferTooShortForPayload);
+    }
+    destination_stream_reader.restart(crc_region_end);  // set up to read the crc
 
-    frame_parse_result =
-        ValidateCRC(destination_stream_reader, out_frame,
-                    etl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(crc_region.data()), crc_region.size()));
+    frame_parse_result = ValidateCRC(destination_stream_reader, crc);
     if (!frame_parse_result) {
         return etl::unexpected(frame_parse_result.error());
     }
@@ -411,8 +843,73 @@ etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrame(etl::byte_strea
     return result;
 }
 
+}  // namespace
+
+etl::expected<FrameReadResult, FrameParseError> ReadFrame(etl::byte_stream_reader& stream, Frame& out_frame) {
+    const etl::expected<FrameReadResult, FrameParseError> read = ReadFrameUncounted(stream, out_frame, nullptr);
+    CountRead(read, out_frame, 0U);
+    return read;
+}
+
+etl::expected<FrameReadResult, FrameParseError> ReadFrame(etl::byte_stream_reader& stream, Frame& out_frame,
+                                                          const AcceptanceFilter& filter) {
+    const etl::expected<FrameReadResult, FrameParseError> read = ReadFrameUncounted(stream, out_frame, &filter);
+    CountRead(read, out_frame, 0U);
+    return read;
+}
+
+etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrame(etl::byte_stream_reader& input_stream,
+                                                                 etl::span<uint8_t> destination_buffer,
+                                                                 Frame& out_frame, uint8_t bit_slip_count) {
+    const etl::expected<FrameReadResult, FrameParseError> read =
+        ReadAndCopyFrameUncounted(input_stream, destination_buffer, out_frame, bit_slip_count, nullptr);
+    CountRead(read, out_frame, bit_slip_count);
+    return read;
+}
+
+etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrame(etl::byte_stream_reader& input_stream,
+                                                                 etl::span<uint8_t> destination_buffer,
+                                                                 Frame& out_frame, uint8_t bit_slip_count,
+                                                                 const AcceptanceFilter& filter) {
+    const etl::expected<FrameReadResult, FrameParseError> read =
+        ReadAndCopyFrameUncounted(input_stream, destination_buffer, out_frame, bit_slip_count, &filter);
+    CountRead(read, out_frame, bit_slip_count);
+    return read;
+}
+
 namespace impl {
 
+size_t ScanForPreambleByte(const etl::span<const uint8_t>& buffer, size_t offset, bool include_complement) {
+    return PreambleCandidateCursor(buffer, offset, include_complement).Next();
+}
+
+size_t ScanForPreambleWord(const etl::span<const uint8_t>& buffer, size_t offset) {
+    const uint8_t* data = buffer.data();
+    const size_t length = buffer.size();
+    size_t index = offset;
+#ifdef SPIOPEN_FRAME_READER_SIMD
+    for (; index + scan_block_size + 1U <= length; index += scan_block_size) {
+        const uint64_t matches = MatchPreambleWords(data + index);
+        if (matches != 0U) {
+            return index + FirstMatch(matches);
+        }
+    }
+    for (; index + 1U < length; ++index) {
+        if ((data[index] == PREAMBLE_BYTE) && (data[index + 1U] == PREAMBLE_BYTE)) {
+            return index;
+        }
+    }
+#else
+    PreambleCandidateCursor candidates(buffer, index, false);
+    for (index = candidates.Next(); index + 1U < length; index = candidates.Next()) {
+        if (data[index + 1U] == PREAMBLE_BYTE) {
+            return index;
+        }
+    }
+#endif
+    return length;
+}
+
 /**
  * @brief Search for a SpIOpen frame preamble in a byte array buffer
  * @param buffer Pointer to the byte array buffer to find the preamble in
@@ -427,28 +924,22 @@ etl::expected<size_t, FrameParseError> FindNextPreambleByte(const etl::span<uint
     if (offset >= buffer.size()) {
         return etl::unexpected(FrameParseError::BufferTooShortForPreamble);
     }
-    const void* standard_preamble_index = memchr(buffer.data() + offset, PREAMBLE_BYTE, buffer.size() - offset);
-    if (!bit_slips_allowed) {
-        if (standard_preamble_index == nullptr) {
-            return etl::unexpected(FrameParseError::NoPreamble);
-        }
-        return static_cast<size_t>(static_cast<const uint8_t*>(standard_preamble_index) - buffer.data());
-    }
-
-    // case where bit slips are allowed and we can also search for the complement preamble
-    const void* complement_preamble_index =
-        memchr(buffer.data() + offset, PREAMBLE_BYTE_COMPLEMENT, buffer.size() - offset);
-    if (standard_preamble_index == nullptr && complement_preamble_index == nullptr) {
+    // when bit slips are allowed the complement preamble is also a candidate; both are found in a single pass
+    const size_t preamble_index =
+        ScanForPreambleByte(etl::span<const uint8_t>(buffer.data(), buffer.size()), offset, bit_slips_allowed);
+    if (preamble_index >= buffer.size()) {
         return etl::unexpected(FrameParseError::NoPreamble);
     }
-    if (standard_preamble_index == nullptr) {
-        return static_cast<size_t>(static_cast<const uint8_t*>(complement_preamble_index) - buffer.data());
-    }
-    if (complement_preamble_index == nullptr) {
-        return static_cast<size_t>(static_cast<const uint8_t*>(standard_preamble_index) - buffer.data());
-    }
-    return static_cast<size_t>(std::min(static_cast<const uint8_t*>(standard_preamble_index) - buffer.data(),
-                                        static_cast<const uint8_t*>(complement_preamble_index) - buffer.data()));
+    return preamble_index;
+}
+
+uint8_t MatchPreambleSlips(const uint8_t previous_byte, const uint8_t candidate_byte, const uint8_t next_byte,
+                           const bool has_previous_byte) {
+    const uint8_t candidate = (candidate_byte == PREAMBLE_BYTE)              ? even_slips
+                              : (candidate_byte == PREAMBLE_BYTE_COMPLEMENT) ? odd_slips
+                                                                             : 0x00U;
+    const uint8_t previous = has_previous_byte ? preamble_slip_tables.previous[previous_byte] : 0x01U;
+    return static_cast<uint8_t>(candidate & previous & preamble_slip_tables.next[next_byte]);
 }
 
 /**
@@ -465,87 +956,398 @@ etl::expected<uint8_t, FrameParseError> CountBitOffsetIntoPreviousByte(const etl
     if (preamble_index + 1U >= buffer.size()) {  // we will always need to search the next byte
         return etl::unexpected(FrameParseError::BufferTooShortForPreamble);
     }
+    const bool has_previous_byte = preamble_index > 0U;
+    const uint8_t slips =
+        MatchPreambleSlips(has_previous_byte ? buffer[preamble_index - 1U] : 0U, buffer[preamble_index],
+                           buffer[preamble_index + 1U], has_previous_byte);
+    if (slips == 0U) {
+        return etl::unexpected(FrameParseError::NoPreamble);
+    }
+    const uint8_t slip = EarliestPreambleSlip(slips);
+    return (slip == 0U) ? 0U : static_cast<uint8_t>(8U - slip);
+}
 
-    uint8_t index_byte = buffer[preamble_index];
-    uint8_t next_byte = buffer[preamble_index + 1U];
+}  // namespace impl
 
-    // The only way to return a success if the preambel_index is the first byte in the buffer is if the preamble is
-    // perfectly aligned with our buffer (probably the most common case anyway)
-    if (preamble_index == 0U) {
-        if ((index_byte == PREAMBLE_BYTE) && (next_byte == PREAMBLE_BYTE)) {
-            return 0U;  // no bit offsets
-        }
-        return etl::unexpected(FrameParseError::NoPreamble);  // searching algorithm will likely advance the cursor and
-                                                              // inspect the next byte, with lookback to this first byte
+etl::expected<size_t, FrameParseError> PeekFrameLength(const etl::span<const uint8_t>& prefix,
+                                                       const uint8_t bit_slip_count) {
+    if (bit_slip_count > 7U) {
+        return etl::unexpected(FrameParseError::InvalidBitSlipCount);
+    }
+    // a slipped field ends part way into the byte after it
+    const size_t slip_byte = (bit_slip_count == 0U) ? 0U : 1U;
+    if (prefix.size() < PREAMBLE_SIZE + FORMAT_HEADER_SIZE + slip_byte) {
+        return etl::unexpected(FrameParseError::BufferTooShortToDetermineLength);
+    }
+    const uint8_t* bytes = prefix.data();
+    if ((RealignedByte(bytes, 0U, bit_slip_count) != PREAMBLE_BYTE) ||
+        (RealignedByte(bytes, 1U, bit_slip_count) != PREAMBLE_BYTE)) {
+        return etl::unexpected(FrameParseError::NoPreamble);
     }
-    // now we know that the previous byte is safe to read. The only question is, how many bits into the previous byte
-    // does the preamble pattern extend?
-    uint8_t previous_byte_pattern_match = ~(
-        buffer[preamble_index - 1U] ^ index_byte);  // remember that the index byte has either the preamble data or its
-                                                    // complement, but that pattern should match across byte boundaries
 
-    // bit slip will be either odd or even depending on whether the idnex has a true preamble or complement
-    uint8_t out_bit_offset = 6U;  // case where the true preamble is in the index position
-    if (index_byte == PREAMBLE_BYTE_COMPLEMENT) {
-        if ((previous_byte_pattern_match & 1U) == 0U) {
-            return etl::unexpected(FrameParseError::NoPreamble);  // likely 7 bits of slip on the *next* buffer index
-        }
-        out_bit_offset =
-            7U;  // now we know that we see a matching true preamble (not complement) one bit higher.
-                 // So we can search just for the true preamble on odd slips (default is true preamble on even slips).
+    Frame header;
+    bool dlc_corrected = false;
+    size_t payload_len = 0U;
+    auto parse_result = ParseFormatHeader(RealignedByte(bytes, PREAMBLE_SIZE, bit_slip_count),
+                                          RealignedByte(bytes, PREAMBLE_SIZE + 1U, bit_slip_count), header,
+                                          dlc_corrected, payload_len);
+    if (parse_result) {
+        parse_result = CheckFrameTypeEnabled(header);
+    }
+    if (!parse_result) {
+        return etl::unexpected(parse_result.error());
     }
-    uint8_t next_byte_pattern_match = ~(next_byte ^ index_byte);
-    uint8_t pattern_mask =
-        (0xFFU) >> (8U - out_bit_offset);  // describes the bits of the previous byte that are part of the preamble
-                                           // pattern. Will shift them out as we search for smaller and smaller shifts
-    while (out_bit_offset > 1U) {  // we already know that bit_slip of 1 is a match if we are searching for odd slips,
-        // but its our worst possible odd match.
-        uint8_t pattern_mask_complement = (~pattern_mask);
-        bool previous_byte_matches = (previous_byte_pattern_match & pattern_mask);
-        bool next_byte_matches = (next_byte_pattern_match & pattern_mask_complement);
-        if (((previous_byte_pattern_match & pattern_mask) == pattern_mask) &&
-            ((next_byte_pattern_match & pattern_mask_complement) == pattern_mask_complement)) {
-            return out_bit_offset;
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    if (header.can_flags.XLF) {
+        if (prefix.size() < LENGTH_PREFIX_SIZE + slip_byte) {
+            return etl::unexpected(FrameParseError::BufferTooShortToDetermineLength);
+        }
+        const size_t xl_length_index = PREAMBLE_SIZE + FORMAT_HEADER_SIZE;
+        const uint16_t encoded = static_cast<uint16_t>(
+            (static_cast<uint16_t>(RealignedByte(bytes, xl_length_index, bit_slip_count)) << 8U) |
+            RealignedByte(bytes, xl_length_index + 1U, bit_slip_count));
+        const algorithms::Secded16DecodeResult decoded = algorithms::Secded16Decode11(encoded);
+        if (decoded.uncorrectable) {
+            return etl::unexpected(FrameParseError::FormatDlcCorrupted);
+        }
+        payload_len = static_cast<size_t>(decoded.data11);
+        if (payload_len > MAX_XL_PAYLOAD_SIZE) {
+            return etl::unexpected(FrameParseError::DlcInvalid);
         }
-        out_bit_offset -= 2U;
-        pattern_mask >>= 2U;
     }
-    return out_bit_offset;
+#endif
+
+    return GetWireFrameLength(header, payload_len);
 }
 
-}  // namespace impl
+namespace {
+
+etl::expected<FrameReadResult, FrameParseError> ReadAndCopyWrappedFrame(const WrappedBuffer& input, const size_t offset,
+                                                                        etl::span<uint8_t> destination_buffer,
+                                                                        Frame& out_frame,
+                                                                        const uint8_t bit_slip_count) {
+    out_frame.Reset();
+    if (bit_slip_count > 7U) {
+        return etl::unexpected(FrameParseError::InvalidBitSlipCount);
+    }
+    const size_t first_size = input.first.size();
+    if ((offset >= first_size) || input.second.empty()) {  // all in one part
+        const etl::span<uint8_t> part = (offset >= first_size) ? input.second.subspan(offset - first_size)
+                                                               : input.first.subspan(offset);
+        etl::byte_stream_reader stream(part.data(), part.size(), etl::endian::big);
+        return ReadAndCopyFrameUncounted(stream, destination_buffer, out_frame, bit_slip_count, nullptr);
+    }
+
+    // the frame starts before the wrap; its length says whether it runs past it
+    const size_t slip_byte = (bit_slip_count == 0U) ? 0U : 1U;
+    const size_t available = input.size() - offset;
+    if (available < PREAMBLE_SIZE + slip_byte) {
+        return etl::unexpected(FrameParseError::BufferTooShortForPreamble);
+    }
+    uint8_t prefix[LENGTH_PREFIX_SIZE + 1U];
+    const size_t prefix_size = (available < sizeof(prefix)) ? available : sizeof(prefix);
+    for (size_t i = 0U; i < prefix_size; ++i) {
+        prefix[i] = input[offset + i];
+    }
+    auto frame_length = PeekFrameLength(etl::span<const uint8_t>(prefix, prefix_size), bit_slip_count);
+    if (!frame_length) {
+        return etl::unexpected(frame_length.error());
+    }
+    const size_t source_length = *frame_length + slip_byte;
+    if (offset + source_length <= first_size) {
+        etl::byte_stream_reader stream(input.first.data() + offset, first_size - offset, etl::endian::big);
+        return ReadAndCopyFrameUncounted(stream, destination_buffer, out_frame, bit_slip_count, nullptr);
+    }
+    if ((available < source_length) || (destination_buffer.size() < *frame_length)) {
+        return etl::unexpected(FrameParseError::BufferTooShortForPayload);
+    }
+
+    // realign each part into place; only the output byte made from the last byte before the wrap and the first byte
+    // after it needs both
+    const size_t first_part = first_size - offset;
+    uint8_t* dest = destination_buffer.data();
+    const uint8_t* source = input.first.data() + offset;
+    if (bit_slip_count == 0U) {
+        std::memcpy(dest, source, first_part);
+        std::memcpy(dest + first_part, input.second.data(), *frame_length - first_part);
+    } else {
+        RealignBitSlipped(source, dest, first_part - 1U, bit_slip_count);
+        const uint16_t last_before_wrap = source[first_part - 1U];
+        dest[first_part - 1U] = static_cast<uint8_t>((last_before_wrap << bit_slip_count) |
+                                                     (input.second[0] >> (8U - bit_slip_count)));
+        RealignBitSlipped(input.second.data(), dest + first_part, *frame_length - first_part, bit_slip_count);
+    }
+    etl::byte_stream_reader stream(dest, *frame_length, etl::endian::big);
+    return ReadFrameUncounted(stream, out_frame, nullptr);
+}
+
+}  // namespace
+
+etl::expected<FrameReadResult, FrameParseError> ReadAndCopyFrame(const WrappedBuffer& input, const size_t offset,
+                                                                 etl::span<uint8_t> destination_buffer,
+                                                                 Frame& out_frame, const uint8_t bit_slip_count) {
+    const etl::expected<FrameReadResult, FrameParseError> read =
+        ReadAndCopyWrappedFrame(input, offset, destination_buffer, out_frame, bit_slip_count);
+    CountRead(read, out_frame, bit_slip_count);
+    return read;
+}
 
 FrameSearchResult FindNextFramePreamble(const etl::span<uint8_t>& buffer, size_t offset, bool bit_slips_allowed) {
     FrameSearchResult result{};
     result.valid_preamble_found = false;
     result.frame_start_offset = offset;  // use this as a working counter for candidate 2-byte preambles
 
-    while (!result.valid_preamble_found) {
-        auto preamble_index = FindNextPreambleByte(buffer, result.frame_start_offset, bit_slips_allowed);
-        if (!preamble_index) {
-            return result;  // give up, no preambles found in the rest of the buffer
+    if (!bit_slips_allowed) {  // only an aligned 2-byte preamble will do, which the scan finds directly
+        const size_t preamble_index =
+            ScanForPreambleWord(etl::span<const uint8_t>(buffer.data(), buffer.size()), offset);
+        if (preamble_index < buffer.size()) {
+            result.valid_preamble_found = true;
+            result.bit_slip_count = 0;
+            result.frame_start_offset = preamble_index;
         }
-        if (bit_slips_allowed) {
-            auto bit_result = CountBitOffsetIntoPreviousByte(buffer, *preamble_index);
-            if (bit_result) {
-                result.valid_preamble_found = true;
-                result.bit_slip_count = static_cast<int8_t>(8U - *bit_result);
-                result.frame_start_offset = *bit_result > 0 ? *preamble_index - 1u : *preamble_index;
-                return result;
+        return result;
+    }
+
+    // A single cursor walks the candidates, so a buffer full of rejected candidates (line noise) is still one pass
+    PreambleCandidateCursor candidates(etl::span<const uint8_t>(buffer.data(), buffer.size()), offset, true);
+    for (size_t preamble_index = candidates.Next(); preamble_index < buffer.size();
+         preamble_index = candidates.Next()) {
+        if (preamble_index + 1U >= buffer.size()) {
+            break;  // a preamble needs the byte after the candidate too
+        }
+        const bool has_previous_byte = preamble_index > 0U;
+        const uint8_t previous_byte = has_previous_byte ? buffer[preamble_index - 1U] : 0U;
+        const uint8_t slips = MatchPreambleSlips(previous_byte, buffer[preamble_index], buffer[preamble_index + 1U],
+                                                 has_previous_byte);
+        if (slips != 0U) {
+            const uint8_t slip = EarliestPreambleSlip(slips);
+            result.valid_preamble_found = true;
+            result.bit_slip_count = static_cast<int8_t>(slip);
+            result.frame_start_offset = (slip > 0U) ? preamble_index - 1u : preamble_index;
+            return result;
+        }
+        // no 2-byte preamble found at this candidate, try the next one
+        result.frame_start_offset = preamble_index + 1u;
+    }
+    return result;  // no preambles found in the rest of the buffer
+}
+
+FrameSearchResult FindNextFramePreamble(const WrappedBuffer& buffer, const size_t offset,
+                                        const bool bit_slips_allowed) {
+    const size_t first_size = buffer.first.size();
+    FrameSearchResult result{};
+    result.valid_preamble_found = false;
+    result.bit_slip_count = 0;
+    result.frame_start_offset = offset;
+    if (offset < first_size) {
+        result = FindNextFramePreamble(buffer.first, offset, bit_slips_allowed);
+        if (result.valid_preamble_found || buffer.second.empty()) {
+            return result;
+        }
+    }
+
+    // candidates in the last byte before the wrap and the first byte after it need bytes from both parts
+    const size_t total_size = buffer.size();
+    if ((first_size > 0U) && !buffer.second.empty()) {
+        for (size_t candidate = (offset > first_size - 1U) ? offset : first_size - 1U;
+             (candidate <= first_size) && (candidate + 1U < total_size); ++candidate) {
+            const bool has_previous_byte = candidate > 0U;
+            const uint8_t previous_byte = has_previous_byte ? buffer[candidate - 1U] : 0U;
+            uint8_t slips = MatchPreambleSlips(previous_byte, buffer[candidate], buffer[candidate + 1U],
+                                               has_previous_byte);
+            if (!bit_slips_allowed) {
+                slips &= 0x01U;
             }
-        } else {
-            if (*preamble_index + 1U < buffer.size() && buffer[*preamble_index + 1U] == PREAMBLE_BYTE) {
+            if (slips != 0U) {
+                const uint8_t slip = EarliestPreambleSlip(slips);
                 result.valid_preamble_found = true;
-                result.bit_slip_count = 0U;
-                result.frame_start_offset = *preamble_index;
+                result.bit_slip_count = static_cast<int8_t>(slip);
+                result.frame_start_offset = (slip > 0U) ? candidate - 1U : candidate;
                 return result;
             }
         }
-        // no 2-byte preamble found. increment the search pointer and try again
-        result.frame_start_offset = *preamble_index + 1u;
-        continue;
     }
-    return result;  // should never get here
+
+    // the first byte after the wrap was checked above with the byte before it
+    size_t second_offset = (offset > first_size) ? offset - first_size : 0U;
+    if ((first_size > 0U) && (second_offset == 0U)) {
+        second_offset = 1U;
+    }
+    result = FindNextFramePreamble(buffer.second, second_offset, bit_slips_allowed);
+    if (result.valid_preamble_found) {
+        result.frame_start_offset += first_size;
+    } else {
+        result.frame_start_offset = total_size;
+    }
+    return result;
+}
+
+namespace {
+
+// A frame may be cut off by the end of the buffer, rather than corrupt, if it failed for want of bytes and started
+// within one maximum-size frame of the end
+bool IsFrameCutOff(const FrameParseError error, const size_t bytes_left) {
+    const bool buffer_too_short = (error == FrameParseError::BufferTooShortForPreamble) ||
+                                  (error == FrameParseError::BufferTooShortToDetermineLength) ||
+                                  (error == FrameParseError::BufferTooShortForHeader) ||
+                                  (error == FrameParseError::BufferTooShortForPayload);
+    return buffer_too_short && (bytes_left <= MAX_CAN_XL_FRAME_SIZE + 1U);  // + 1 for the shared byte of a slip
+}
+
+
+void DescribeFrame(FrameDescriptor& descriptor, const size_t offset, const uint8_t bit_slip_count,
+                   const etl::expected<FrameReadResult, FrameParseError>& read, const Frame& frame) {
+    descriptor.offset = offset;
+    descriptor.bit_slip_count = bit_slip_count;
+    descriptor.valid = read.has_value();
+    descriptor.dlc_corrected = read.has_value() && read->dlc_corrected;
+    descriptor.error = read.has_value() ? FrameParseError::NoPreamble : read.error();
+    descriptor.length = 0U;
+    descriptor.can_identifier = 0U;
+    if (read.has_value() || (read.error() == FrameParseError::CrcMismatch)) {  // the header was read in full
+        descriptor.can_identifier = frame.can_identifier;
+        if (!frame.TryGetFrameLength(descriptor.length)) {
+            descriptor.length = 0U;
+        }
+    }
+}
+
+// Count the bytes between the end of the last valid frame and position as passed over during resync
+void CountResyncBytesUntil(const size_t previous_frame_end, const size_t position) {
+    if (position > previous_frame_end) {
+        CountResyncBytes(position - previous_frame_end);
+    }
+}
+
+}  // namespace
+
+ParseAllResult ParseAll(const etl::span<uint8_t>& buffer, const etl::span<FrameDescriptor>& descriptors,
+                        const etl::span<uint8_t>& scratch_buffer, const bool bit_slips_allowed,
+                        const bool end_of_data) {
+    ParseAllResult result{};
+    result.descriptor_count = 0U;
+    Frame frame;
+    size_t search_offset = 0U;
+    size_t previous_frame_end = 0U;  // slipped frames start in this byte at the earliest
+    bool has_failure = false;
+    size_t failure_position = 0U;     // bit position of the last failed frame reported
+    while (true) {
+        const FrameSearchResult found = FindNextFramePreamble(buffer, search_offset, bit_slips_allowed);
+        if (!found.valid_preamble_found) {
+            // keep the last bytes, they may be the start of a preamble completed by the next data
+            size_t tail_start = (buffer.size() > PREAMBLE_SIZE) ? buffer.size() - PREAMBLE_SIZE : 0U;
+            if (end_of_data) {
+                tail_start = buffer.size();
+            }
+            result.resume_offset = (search_offset > tail_start) ? search_offset : tail_start;
+            CountResyncBytesUntil(previous_frame_end, result.resume_offset);
+            return result;
+        }
+
+        // A candidate can match at several slips (the byte before a frame may happen to end in preamble bits), so try
+        // each in the order FindNextFramePreamble() prefers them
+        const size_t candidate = found.frame_start_offset + ((found.bit_slip_count > 0) ? 1U : 0U);
+        uint8_t slips = 0x01U;
+        if (bit_slips_allowed) {
+            const bool has_previous_byte = candidate > 0U;
+            slips = MatchPreambleSlips(has_previous_byte ? buffer[candidate - 1U] : 0U, buffer[candidate],
+                                       buffer[candidate + 1U], has_previous_byte);
+            if (candidate <= previous_frame_end) {
+                slips &= 0x01U;  // the byte before is part of the previous frame
+            }
+        }
+        search_offset = candidate + 1U;
+        if (slips == 0U) {
+            continue;
+        }
+
+        FrameDescriptor descriptor{};
+        bool described = false;
+        bool cut_off = false;
+        for (uint8_t n = 1U; n <= 8U; ++n) {
+            const uint8_t bit_slip_count = n & 0x07U;  // slips 1 to 7, then 0
+            if ((slips & (1U << bit_slip_count)) == 0U) {
+                continue;
+            }
+            const size_t frame_offset = (bit_slip_count == 0U) ? candidate : candidate - 1U;
+            etl::byte_stream_reader input(buffer.data() + frame_offset, buffer.size() - frame_offset,
+                                          etl::endian::big);
+            const etl::expected<FrameReadResult, FrameParseError> read =
+                (bit_slip_count == 0U)
+                    ? ReadFrameUncounted(input, frame, nullptr)
+                    : ReadAndCopyFrameUncounted(input, scratch_buffer, frame, bit_slip_count, nullptr);
+            if (read) {
+                DescribeFrame(descriptor, frame_offset, bit_slip_count, read, frame);
+                described = true;
+                break;
+            }
+            // With no more data to come a frame cut off by the end of the buffer is reported as failed like any other,
+            // so a false preamble with a long length field does not hide the frames after it
+            if (!end_of_data && IsFrameCutOff(read.error(), buffer.size() - frame_offset)) {
+                cut_off = true;
+                continue;
+            }
+            // The preamble pattern read an even number of bits later is still a preamble, so a failed frame would be
+            // reported again at up to seven more positions; only the first is
+            const size_t position = frame_offset * 8U + bit_slip_count;
+            const size_t distance = position - failure_position;
+            const bool alias = has_failure && (position > failure_position) && (distance < PREAMBLE_SIZE * 8U) &&
+                               ((distance % 2U) == 0U);
+            if (!described && !alias) {
+                DescribeFrame(descriptor, frame_offset, bit_slip_count, read, frame);
+                described = true;
+            }
+        }
+
+        if (described && (result.descriptor_count == descriptors.size())) {
+            result.resume_offset = descriptor.offset;  // the next call finds this frame again
+            CountResyncBytesUntil(previous_frame_end, result.resume_offset);
+            return result;
+        }
+        if (described && descriptor.valid) {
+            CountResyncBytesUntil(previous_frame_end, descriptor.offset);
+            CountFrame(frame.can_flags, descriptor.length, descriptor.dlc_corrected, descriptor.bit_slip_count);
+            search_offset = descriptor.offset + descriptor.length;
+            previous_frame_end = search_offset;
+        } else if (cut_off) {
+            result.resume_offset = ((slips & 0xFEU) != 0U) ? candidate - 1U : candidate;
+            CountResyncBytesUntil(previous_frame_end, result.resume_offset);
+            return result;
+        } else if (described) {
+            CountParseError(descriptor.error);
+            has_failure = true;
+            failure_position = descriptor.offset * 8U + descriptor.bit_slip_count;
+        }
+        if (described) {
+            descriptors[result.descriptor_count++] = descriptor;
+        }
+    }
+}
+
+FrameSearchResult PreambleDetector::Push(const uint8_t byte) {
+    window_ = ((window_ << 8U) | byte) & 0x00FFFFFFU;
+    ++bytes_pushed_;
+    slips_ = 0U;
+
+    FrameSearchResult result{};
+    result.valid_preamble_found = false;
+    result.bit_slip_count = 0;
+    result.frame_start_offset = 0U;
+    if (bytes_pushed_ < 2U) {
+        return result;
+    }
+    const bool has_previous_byte = bytes_pushed_ > 2U;
+    const uint8_t slips = MatchPreambleSlips(static_cast<uint8_t>(window_ >> 16U), static_cast<uint8_t>(window_ >> 8U),
+                                             static_cast<uint8_t>(window_), has_previous_byte);
+    if (slips == 0U) {
+        return result;
+    }
+    slips_ = slips;
+    const uint8_t slip = EarliestPreambleSlip(slips);
+    result.valid_preamble_found = true;
+    result.bit_slip_count = static_cast<int8_t>(slip);
+    result.frame_start_offset = bytes_pushed_ - ((slip == 0U) ? 2U : 3U);
+    return result;
 }
 
 }  // namespace spiopen::frame_reader
@@ -0,0 +1,61 @@
+/*
+SpIOpen Frame Statistics : Implementation
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+*/
+
+#include "spiopen_frame_statistics.h"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef CONFIG_SPIOPEN_FRAME_READER_STATISTICS
+
+namespace spiopen::frame_reader {
+
+namespace impl {
+
+ReaderStatisticsCounters reader_statistics_counters{};
+
+}  // namespace impl
+
+using namespace impl;
+
+ReaderStatistics GetReaderStatistics() {
+    const ReaderStatisticsCounters& counters = reader_statistics_counters;
+    ReaderStatistics statistics{};
+    statistics.cc_frames = counters.cc_frames.load(std::memory_order_relaxed);
+    statistics.fd_frames = counters.fd_frames.load(std::memory_order_relaxed);
+    statistics.xl_frames = counters.xl_frames.load(std::memory_order_relaxed);
+    statistics.frame_bytes = counters.frame_bytes.load(std::memory_order_relaxed);
+    statistics.corrected_headers = counters.corrected_headers.load(std::memory_order_relaxed);
+    for (size_t i = 0U; i < FRAME_PARSE_ERROR_COUNT; ++i) {
+        statistics.parse_errors[i] = counters.parse_errors[i].load(std::memory_order_relaxed);
+    }
+    for (size_t i = 0U; i < BIT_SLIP_COUNTS; ++i) {
+        statistics.bit_slips[i] = counters.bit_slips[i].load(std::memory_order_relaxed);
+    }
+    statistics.resync_bytes = counters.resync_bytes.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+void ResetReaderStatistics() {
+    ReaderStatisticsCounters& counters = reader_statistics_counters;
+    counters.cc_frames.store(0U, std::memory_order_relaxed);
+    counters.fd_frames.store(0U, std::memory_order_relaxed);
+    counters.xl_frames.store(0U, std::memory_order_relaxed);
+    counters.frame_bytes.store(0U, std::memory_order_relaxed);
+    counters.corrected_headers.store(0U, std::memory_order_relaxed);
+    for (std::atomic<uint32_t>& counter : counters.parse_errors) {
+        counter.store(0U, std::memory_order_relaxed);
+    }
+    for (std::atomic<uint32_t>& counter : counters.bit_slips) {
+        counter.store(0U, std::memory_order_relaxed);
+    }
+    counters.resync_bytes.store(0U, std::memory_order_relaxed);
+}
+
+}  // namespace spiopen::frame_reader
+
+#endif
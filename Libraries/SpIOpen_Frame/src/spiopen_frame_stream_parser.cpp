@@ -0,0 +1,485 @@
+/*
+SpIOpen Frame Stream Parser : Implementation
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+*/
+
+#include "spiopen_frame_stream_parser.h"
+
+#include <etl/byte_stream.h>
+#include <etl/expected.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "spiopen_frame_statistics.h"
+
+namespace spiopen::frame_reader {
+
+using namespace spiopen::format;
+using namespace impl;
+
+namespace {
+
+// The slip of the earliest frame start: slips 1 to 7 start in the byte before the preamble byte, slip 0 at it
+uint8_t EarliestSlip(const uint8_t slips) {
+    const uint8_t slipped = static_cast<uint8_t>(slips & 0xFEU);
+    return (slipped != 0U) ? static_cast<uint8_t>(__builtin_ctz(slipped)) : 0U;
+}
+
+}  // namespace
+
+void FrameStreamParser::Reset() {
+    detector_.Reset();
+    state_ = State::SearchingPreamble;
+    bit_slip_count_ = 0U;
+    preamble_slips_ = 0U;
+    candidate_slips_ = 0U;
+    first_error_ = FrameParseError::NoPreamble;
+    carry_ = 0U;
+    tail_pending_ = false;
+    tail_bit_offset_ = 0U;
+    tail_bytes_ = 0U;
+    search_start_bit_ = 0U;
+    replay_position_ = 0U;
+    replay_length_ = 0U;
+    write_position_ = 0U;
+    target_position_ = 0U;
+    payload_length_ = 0U;
+    frame_length_ = 0U;
+    crc_position_ = 0U;
+    crc_ = FrameCrc(0U);
+    frame_.Reset();
+    read_result_.dlc_corrected = false;
+}
+
+FeedResult FrameStreamParser::Feed(const etl::span<const uint8_t>& chunk) {
+    if (tail_pending_) {  // the frame reported last is no longer needed
+        PrepareReplay();
+    }
+    while (replay_position_ < replay_length_) {
+        // bytes kept from earlier chunks come first; the frame they start is realigned behind them, in place
+        const FeedResult replayed =
+            Consume(frame_buffer_.data() + replay_position_, replay_length_ - replay_position_);
+        replay_position_ += replayed.bytes_consumed;
+        if (replayed.status != FeedStatus::NeedMoreData) {
+            return FeedResult{0U, replayed.status, replayed.error};
+        }
+    }
+    replay_position_ = 0U;
+    replay_length_ = 0U;
+
+    FeedResult result = Consume(chunk.data(), chunk.size());
+    if (tail_pending_) {
+        // hand back the bytes to search again that came from this chunk, so they are searched when it is fed again
+        const size_t handed_back = (tail_bytes_ < result.bytes_consumed) ? tail_bytes_ : result.bytes_consumed;
+        result.bytes_consumed -= handed_back;
+        tail_bytes_ -= handed_back;
+    }
+    return result;
+}
+
+FeedResult FrameStreamParser::Consume(const uint8_t* data, const size_t size) {
+    size_t consumed = 0U;
+    while (true) {
+        if (state_ == State::SearchingPreamble) {
+            if (consumed == size) {
+                break;
+            }
+            const uint8_t byte = data[consumed++];
+            if (!detector_.Push(byte).valid_preamble_found) {
+                continue;
+            }
+            const uint8_t slips = detector_.GetPreambleSlips() & GetSlipsAfterTail();
+            if (slips == 0U) {
+                continue;
+            }
+            // searched since the last frame ended or was dropped
+            CountResyncBytes(detector_.GetBytesPushed() - ((EarliestSlip(slips) != 0U) ? 3U : 2U));
+            if (frame_buffer_.size() < PREAMBLE_SIZE + FORMAT_HEADER_SIZE) {
+                return DropFrame(consumed, FrameParseError::BufferTooShortForHeader);
+            }
+            StartFrame(slips, byte);
+            continue;
+        }
+
+        if (write_position_ < target_position_) {
+            // realign as much as the next parse step needs, or the rest of the input if it ends first
+            const size_t wanted = target_position_ - write_position_;
+            const size_t available = size - consumed;
+            const size_t count = (wanted < available) ? wanted : available;
+            if (count == 0U) {
+                break;
+            }
+            Append(data + consumed, count);
+            consumed += count;
+            if (write_position_ < target_position_) {
+                break;  // input used up mid-field
+            }
+        }
+
+        FrameParseError error;
+        if (state_ == State::ReceivingHeader) {
+            auto header = ParseHeaderPrefix();
+            if (header) {
+                if (*header) {
+                    CheckLaterSlips();
+                }
+                continue;
+            }
+            error = header.error();
+        } else if (write_position_ < frame_length_) {
+            CheckLaterSlips();  // the frame at a later slip ends here
+            continue;
+        } else {
+            auto finished = FinishFrame();
+            if (finished) {
+                CountFrame(frame_.can_flags, frame_length_, read_result_.dlc_corrected, bit_slip_count_);
+                if ((bit_slip_count_ == 0U) && ((preamble_slips_ & 0xFEU) != 0U)) {
+                    CountResyncBytes(1U);  // the byte before the preamble byte, counted as the frame start until now
+                }
+                // a slipped frame ends part way through the last byte received, which may already hold the start of
+                // the next preamble, and a frame found at a later slip may end before the last byte received
+                KeepTail(frame_length_ * 8U - bit_slip_count_, bit_slip_count_);
+                return FeedResult{consumed, FeedStatus::FrameComplete, FrameParseError::NoPreamble};
+            }
+            error = finished.error();
+        }
+        if (!RetryNextSlip(error)) {
+            return DropFrame(consumed, first_error_);
+        }
+    }
+    return FeedResult{consumed, FeedStatus::NeedMoreData, FrameParseError::NoPreamble};
+}
+
+// A preamble found in the first bytes searched again must not start before search_start_bit_ of the first one: in the
+// last bits of the frame before, or at the preamble of a dropped frame
+uint8_t FrameStreamParser::GetSlipsAfterTail() const {
+    if (search_start_bit_ == 0U) {
+        return 0xFFU;
+    }
+    switch (detector_.GetBytesPushed()) {
+        case 2U:  // the preamble byte is the first byte
+            return 0x00U;
+        case 3U:  // a slipped frame starts in the first byte, slip bits in
+            return static_cast<uint8_t>(0x01U | (0xFFU << search_start_bit_));
+        default:
+            return 0xFFU;
+    }
+}
+
+void FrameStreamParser::StartFrame(const uint8_t slips, const uint8_t last_byte) {
+    frame_.Reset();
+    read_result_.dlc_corrected = false;
+    preamble_slips_ = slips;
+    candidate_slips_ = slips;
+    first_error_ = FrameParseError::NoPreamble;
+    bit_slip_count_ = EarliestSlip(slips);
+    search_start_bit_ = 0U;
+    carry_ = last_byte;  // a slipped preamble ends in the byte that completed it
+    frame_buffer_[0] = PREAMBLE_BYTE;
+    frame_buffer_[1] = PREAMBLE_BYTE;
+    write_position_ = PREAMBLE_SIZE;
+    target_position_ = PREAMBLE_SIZE + FORMAT_HEADER_SIZE;
+    state_ = State::ReceivingHeader;
+}
+
+// source may be kept bytes further up the frame buffer, so the copy has to allow for overlap
+void FrameStreamParser::Append(const uint8_t* source, const size_t count) {
+    uint8_t* dest = frame_buffer_.data() + write_position_;
+    if (bit_slip_count_ == 0U) {
+        std::memmove(dest, source, count);
+    } else {
+        dest[0] = static_cast<uint8_t>((static_cast<uint16_t>(carry_) << bit_slip_count_) |
+                                       (source[0] >> (8U - bit_slip_count_)));
+        RealignBitSlipped(source, dest + 1U, count - 1U, bit_slip_count_);
+        carry_ = source[count - 1U];
+    }
+    write_position_ += count;
+
+    if (state_ == State::ReceivingBody) {
+        FoldCrc();
+    }
+}
+
+// Fold the protected region received so far into the CRC, while it is still in cache
+void FrameStreamParser::FoldCrc() {
+    const size_t crc_end = frame_length_ - crc_.GetSize();
+    const size_t fold_end = (write_position_ < crc_end) ? write_position_ : crc_end;
+    if (fold_end > crc_position_) {
+        crc_.Add(etl::span<const uint8_t>(frame_buffer_.data() + crc_position_, fold_end - crc_position_));
+        crc_position_ = fold_end;
+    }
+}
+
+// Bits from the start of the current slip's frame to the start of the frame at a later slip of the same preamble:
+// the difference in slips, and for slip 0 a whole byte after the byte slips 1 to 7 start in
+size_t FrameStreamParser::GetSlipBitOffset(const uint8_t slip) const {
+    return ((slip == 0U) ? 8U : slip) - bit_slip_count_;
+}
+
+// Byte index of the realigned bytes read from bit_offset on, followed by the unused low bits of the last byte
+// received when slipped. The bits read must have been received.
+uint8_t FrameStreamParser::GetShiftedByte(const size_t bit_offset, const size_t index) const {
+    const size_t position = bit_offset / 8U + index;
+    const uint8_t shift = static_cast<uint8_t>(bit_offset % 8U);
+    const uint8_t high = frame_buffer_[position];
+    if (shift == 0U) {
+        return high;
+    }
+    const uint8_t low = (position + 1U < write_position_) ? frame_buffer_[position + 1U]
+                                                           : static_cast<uint8_t>(carry_ << bit_slip_count_);
+    return static_cast<uint8_t>((high << shift) | (low >> (8U - shift)));
+}
+
+// Drop the first bit_offset bits of the realigned bytes and move the rest to the front of the frame buffer, followed by
+// the unused bits of the last byte received. Moves a frame to a later slip of its preamble, and turns the bytes after
+// a frame back into received bytes.
+void FrameStreamParser::ShiftFrameBuffer(const size_t bit_offset) {
+    if (bit_slip_count_ == 0U) {
+        carry_ = frame_buffer_[write_position_ - 1U];  // realigned whole; the new slip may leave some of it unused
+    }
+    const size_t unused_bits = (bit_slip_count_ != 0U) ? 8U - bit_slip_count_ : 0U;
+    const size_t bit_count = write_position_ * 8U + unused_bits - bit_offset;
+    const size_t byte_count = bit_count / 8U;
+    for (size_t i = 0U; i < byte_count; ++i) {  // reads at or after the byte it writes
+        frame_buffer_[i] = GetShiftedByte(bit_offset, i);
+    }
+    write_position_ = byte_count;
+    const size_t remaining_bits = bit_count % 8U;
+    bit_slip_count_ = (remaining_bits != 0U) ? static_cast<uint8_t>(8U - remaining_bits) : 0U;
+}
+
+// The frame failed at the current slip: move on to the next slip its preamble fits at and parse the bytes already
+// received again from there. Returns false once every slip has failed.
+bool FrameStreamParser::RetryNextSlip(const FrameParseError error) {
+    if (first_error_ == FrameParseError::NoPreamble) {
+        first_error_ = error;
+    }
+    candidate_slips_ = static_cast<uint8_t>(candidate_slips_ & ~(1U << bit_slip_count_));
+    if (candidate_slips_ == 0U) {
+        return false;
+    }
+    ShiftFrameBuffer(GetSlipBitOffset(EarliestSlip(candidate_slips_)));
+    frame_.Reset();
+    read_result_.dlc_corrected = false;
+    target_position_ = PREAMBLE_SIZE + FORMAT_HEADER_SIZE;
+    state_ = State::ReceivingHeader;
+    return true;
+}
+
+// The frame ended (completed or dropped): search the bytes received from the one that holds bit bit_offset of the
+// realigned bytes again, with no frame starting before search_start_bit of that byte. They stay in the frame buffer
+// until the next Feed(), so a completed frame can be read.
+void FrameStreamParser::KeepTail(const size_t bit_offset, const uint8_t search_start_bit) {
+    const size_t unused_bits = (bit_slip_count_ != 0U) ? 8U - bit_slip_count_ : 0U;
+    tail_bit_offset_ = bit_offset;
+    tail_bytes_ = (write_position_ * 8U + unused_bits - bit_offset) / 8U;
+    search_start_bit_ = search_start_bit;
+    tail_pending_ = true;
+    state_ = State::SearchingPreamble;
+    detector_.Reset();
+}
+
+// Turn the bytes to search again back into received bytes at the front of the frame buffer, ahead of any kept bytes
+// not yet searched again
+void FrameStreamParser::PrepareReplay() {
+    tail_pending_ = false;
+    if (tail_bytes_ == 0U) {
+        return;
+    }
+    ShiftFrameBuffer(tail_bit_offset_);
+    // only the first tail_bytes_ are kept; the rest were handed back to the caller
+    const size_t kept_bytes = replay_length_ - replay_position_;
+    std::memmove(frame_buffer_.data() + tail_bytes_, frame_buffer_.data() + replay_position_, kept_bytes);
+    replay_position_ = 0U;
+    replay_length_ = tail_bytes_ + kept_bytes;
+    tail_bytes_ = 0U;
+}
+
+// Decode the fields that give the frame length (format header, and XL length) from the first available realigned bytes
+// of a frame. Returns the frame length, or 0 while more bytes are needed.
+etl::expected<size_t, FrameParseError> FrameStreamParser::DecodeFrameLength(const uint8_t* bytes,
+                                                                            const size_t available, Frame& frame,
+                                                                            bool& dlc_corrected,
+                                                                            size_t& payload_length) const {
+    etl::byte_stream_reader reader(bytes, available, etl::endian::big);
+    reader.skip<uint8_t>(PREAMBLE_SIZE);
+    auto parse_result = ReadFormatHeader(reader, frame, dlc_corrected, payload_length);
+    if (!parse_result) {
+        return etl::unexpected(parse_result.error());
+    }
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    if (frame.can_flags.XLF) {
+        if (available < LENGTH_PREFIX_SIZE) {
+            if (LENGTH_PREFIX_SIZE > frame_buffer_.size()) {
+                return etl::unexpected(FrameParseError::BufferTooShortToDetermineLength);
+            }
+            return 0U;
+        }
+        bool xl_corrected = false;  // the format header was already counted above
+        parse_result = ReadXlPayloadLength(reader, frame, xl_corrected, payload_length);
+        if (!parse_result) {
+            return etl::unexpected(parse_result.error());
+        }
+        dlc_corrected = dlc_corrected || xl_corrected;
+    }
+#endif
+
+    size_t frame_length = 0U;
+    frame.payload = etl::span<uint8_t>(frame_buffer_.data(), payload_length);  // only its size is used
+    const bool has_length = frame.TryGetFrameLength(frame_length);
+    frame.payload = {};
+    if (!has_length) {
+        return etl::unexpected(FrameParseError::InvalidFrameLength);
+    }
+    if (frame_length > frame_buffer_.size()) {
+        return etl::unexpected(FrameParseError::BufferTooShortForPayload);
+    }
+    return frame_length;
+}
+
+// Parse the fields that give the frame length. Returns true once the length is known and the body can be received.
+etl::expected<bool, FrameParseError> FrameStreamParser::ParseHeaderPrefix() {
+    auto length =
+        DecodeFrameLength(frame_buffer_.data(), write_position_, frame_, read_result_.dlc_corrected, payload_length_);
+    if (!length) {
+        return etl::unexpected(length.error());
+    }
+    if (*length == 0U) {
+        target_position_ = LENGTH_PREFIX_SIZE;
+        return false;
+    }
+    frame_length_ = *length;
+    crc_ = FrameCrc(payload_length_);
+    crc_position_ = PREAMBLE_SIZE;
+    target_position_ = frame_length_;
+    state_ = State::ReceivingBody;
+    // the header received so far is all protected; the rest is folded in by Append() as it arrives. After a retry at a
+    // later slip, the whole frame may already be in.
+    FoldCrc();
+    return true;
+}
+
+// A frame at a later slip of the preamble may end before the current one, whose length may be wrong: check it as soon
+// as it is all in (without realigning the bytes), rather than waiting for the current frame, and move to it if it
+// passes its CRC check. Until then the end of its header, or of the frame, is the next parse step's target.
+void FrameStreamParser::CheckLaterSlips() {
+    target_position_ = frame_length_;
+    for (uint8_t slip = 0U; slip < 8U; ++slip) {
+        const uint8_t slip_bit = static_cast<uint8_t>(1U << slip);
+        if ((slip == bit_slip_count_) || ((candidate_slips_ & slip_bit) == 0U)) {
+            continue;
+        }
+        // the bytes held are all complete at a later slip too, as it starts in the last byte received's unused bits
+        const size_t bit_offset = GetSlipBitOffset(slip);
+        uint8_t header[LENGTH_PREFIX_SIZE];
+        const size_t header_length = (write_position_ < sizeof(header)) ? write_position_ : sizeof(header);
+        for (size_t i = 0U; i < header_length; ++i) {
+            header[i] = GetShiftedByte(bit_offset, i);
+        }
+        Frame frame;
+        bool dlc_corrected = false;
+        size_t payload_length = 0U;
+        auto length = DecodeFrameLength(header, header_length, frame, dlc_corrected, payload_length);
+        if (!length) {
+            candidate_slips_ = static_cast<uint8_t>(candidate_slips_ & ~slip_bit);
+            continue;
+        }
+        const size_t needed = (*length == 0U) ? LENGTH_PREFIX_SIZE : *length;
+        if (needed >= frame_length_) {
+            continue;  // tried in turn if the current frame fails
+        }
+        if (write_position_ < needed) {
+            target_position_ = (needed < target_position_) ? needed : target_position_;
+            continue;
+        }
+        if (!CheckSlipCrc(bit_offset, payload_length, *length)) {
+            candidate_slips_ = static_cast<uint8_t>(candidate_slips_ & ~slip_bit);
+            continue;
+        }
+        candidate_slips_ = slip_bit;
+        ShiftFrameBuffer(bit_offset);
+        frame_.Reset();
+        read_result_.dlc_corrected = false;
+        target_position_ = PREAMBLE_SIZE + FORMAT_HEADER_SIZE;
+        state_ = State::ReceivingHeader;
+        return;
+    }
+}
+
+// Check the CRC of the frame that starts bit_offset bits into the realigned bytes, which must all be in
+bool FrameStreamParser::CheckSlipCrc(const size_t bit_offset, const size_t payload_length,
+                                     const size_t frame_length) const {
+    FrameCrc crc(payload_length);
+    const size_t crc_end = frame_length - crc.GetSize();
+    uint8_t block[32];
+    for (size_t position = PREAMBLE_SIZE; position < crc_end;) {
+        const size_t count = (crc_end - position < sizeof(block)) ? crc_end - position : sizeof(block);
+        for (size_t i = 0U; i < count; ++i) {
+            block[i] = GetShiftedByte(bit_offset, position + i);
+        }
+        crc.Add(etl::span<const uint8_t>(block, count));
+        position += count;
+    }
+    uint32_t received_crc = 0U;
+    for (size_t position = crc_end; position < frame_length; ++position) {
+        received_crc = (received_crc << 8U) | GetShiftedByte(bit_offset, position);
+    }
+    return received_crc == crc.GetValue();
+}
+
+// The whole frame is in: read the rest of the header and check the CRC, which has been folded in as the bytes arrived
+etl::expected<void, FrameParseError> FrameStreamParser::FinishFrame() {
+    etl::byte_stream_reader reader(frame_buffer_.data(), frame_length_, etl::endian::big);
+    size_t header_prefix = PREAMBLE_SIZE + FORMAT_HEADER_SIZE;
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    if (frame_.can_flags.XLF) {
+        header_prefix += XL_DATA_LENGTH_SIZE;
+    }
+#endif
+    reader.skip<uint8_t>(header_prefix);
+    etl::expected<void, FrameParseError> parse_result;
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    if (frame_.can_flags.XLF) {
+        parse_result = ReadXlControl(reader, frame_);
+        if (!parse_result) {
+            return parse_result;
+        }
+    }
+#endif
+    parse_result = ReadCanID(reader, frame_);
+    if (!parse_result) {
+        return parse_result;
+    }
+    if (frame_.can_flags.TTL) {
+        parse_result = ReadTTL(reader, frame_);
+        if (!parse_result) {
+            return parse_result;
+        }
+    }
+    const size_t header_end = PREAMBLE_SIZE + frame_.GetHeaderLength();
+    frame_.payload = etl::span<uint8_t>(frame_buffer_.data() + header_end, payload_length_);
+
+    reader.skip<uint8_t>(frame_length_ - crc_.GetSize() - header_end);  // payload and padding
+    return ValidateCRC(reader, crc_);
+}
+
+FeedResult FrameStreamParser::DropFrame(const size_t bytes_consumed, const FrameParseError error) {
+    CountParseError(error);
+    if (state_ != State::SearchingPreamble) {
+        // the byte before the preamble byte, if the frame started there; the rest is searched again from the preamble
+        // byte, which can still hold the start of a slipped frame
+        CountResyncBytes(((preamble_slips_ & 0xFEU) != 0U) ? 1U : 0U);
+        KeepTail((bit_slip_count_ != 0U) ? 8U - bit_slip_count_ : 0U, 1U);
+    } else {
+        detector_.Reset();
+        search_start_bit_ = 0U;
+    }
+    frame_.Reset();
+    return FeedResult{bytes_consumed, FeedStatus::FrameDropped, error};
+}
+
+}  // namespace spiopen::frame_reader
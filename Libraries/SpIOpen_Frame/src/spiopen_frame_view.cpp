@@ -0,0 +1,179 @@
+/*
+SpIOpen Frame View : Implementation
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+*/
+
+#include "spiopen_frame_view.h"
+
+#include <etl/byte_stream.h>
+#include <etl/expected.h>
+
+#include <cstddef>
+#include <cstdint>
+
+#include "spiopen_frame_crc.h"
+#include "spiopen_frame_statistics.h"
+
+namespace spiopen::frame_reader {
+
+using namespace spiopen::format;
+using namespace impl;
+
+Frame::Flags FrameView::GetFlags() const {
+    Frame::Flags flags = flags_;
+    const uint8_t cid_b0 = wire_[GetCanIdOffset()];
+    flags.RTR = (cid_b0 & CID_RTR_MASK) != 0U;
+    flags.BRS = (cid_b0 & CID_BRS_MASK) != 0U;
+    flags.ESI = (cid_b0 & CID_ESI_MASK) != 0U;
+    return flags;
+}
+
+uint32_t FrameView::GetCanIdentifier() const {
+    const uint8_t* cid = wire_.data() + GetCanIdOffset();
+    const uint8_t b0 = cid[0] & static_cast<uint8_t>(~(CID_RTR_MASK | CID_BRS_MASK | CID_ESI_MASK));
+    if (flags_.IDE) {
+        return (static_cast<uint32_t>(b0) << 24U) | (static_cast<uint32_t>(cid[1]) << 16U) |
+               (static_cast<uint32_t>(cid[2]) << 8U) | static_cast<uint32_t>(cid[3]);
+    }
+    return (static_cast<uint32_t>(b0) << 8U) | static_cast<uint32_t>(cid[1]);
+}
+
+uint8_t FrameView::GetTimeToLive() const {
+    if (!flags_.TTL) {
+        return 0U;
+    }
+    const size_t cid_length = flags_.IDE ? CAN_IDENTIFIER_SIZE + CAN_IDENTIFIER_EXTENSION_SIZE : CAN_IDENTIFIER_SIZE;
+    return wire_[GetCanIdOffset() + cid_length];
+}
+
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+Frame::XLControl FrameView::GetXlControl() const {
+    Frame::XLControl xl_control{};
+    if (!flags_.XLF) {
+        return xl_control;
+    }
+    const uint8_t* control = wire_.data() + PREAMBLE_SIZE + FORMAT_HEADER_SIZE + XL_DATA_LENGTH_SIZE;
+    xl_control.payload_type = control[0];
+    xl_control.virtual_can_network_id = control[1];
+    xl_control.addressing_field = (static_cast<uint32_t>(control[2]) << 24U) |
+                                  (static_cast<uint32_t>(control[3]) << 16U) |
+                                  (static_cast<uint32_t>(control[4]) << 8U) | static_cast<uint32_t>(control[5]);
+    return xl_control;
+}
+#endif
+
+void FrameView::ToFrame(Frame& out_frame) const {
+    out_frame.Reset();
+    out_frame.can_flags = GetFlags();
+    out_frame.can_identifier = GetCanIdentifier();
+    out_frame.time_to_live = GetTimeToLive();
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    out_frame.xl_control = GetXlControl();
+#endif
+    out_frame.payload = GetPayload();
+}
+
+size_t FrameView::GetCanIdOffset() const {
+    size_t offset = PREAMBLE_SIZE + FORMAT_HEADER_SIZE;
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    if (flags_.XLF) {
+        offset += XL_DATA_LENGTH_SIZE + XL_CONTROL_SIZE;
+    }
+#endif
+    return offset;
+}
+
+size_t FrameView::GetHeaderLength() const {
+    Frame header;
+    header.can_flags = flags_;
+    return header.GetHeaderLength();
+}
+
+namespace {
+
+// The checks ReadFrameView() makes, leaving the decoded format header, the payload length and the frame length in the
+// out parameters. On success the stream is advanced past the frame.
+etl::expected<FrameReadResult, FrameParseError> ValidateWireFrame(etl::byte_stream_reader& stream, Frame& header,
+                                                                  size_t& payload_len, size_t& frame_length) {
+    FrameReadResult result{};
+    result.dlc_corrected = false;
+
+    // the length fields are decoded straight from the buffer; the view decodes the rest from it when asked
+    const uint8_t* frame_start = reinterpret_cast<const uint8_t*>(stream.free_data().data());
+    const size_t bytes_available = stream.available_bytes();
+    if (bytes_available < PREAMBLE_SIZE) {
+        return etl::unexpected(FrameParseError::BufferTooShortForPreamble);
+    }
+    if ((frame_start[0] != PREAMBLE_BYTE) || (frame_start[1] != PREAMBLE_BYTE)) {
+        return etl::unexpected(FrameParseError::NoPreamble);
+    }
+    if (bytes_available < PREAMBLE_SIZE + FORMAT_HEADER_SIZE) {
+        return etl::unexpected(FrameParseError::BufferTooShortToDetermineLength);
+    }
+    auto hdr = ParseFormatHeader(frame_start[2], frame_start[3], header, result.dlc_corrected, payload_len);
+    if (!hdr) {
+        return etl::unexpected(hdr.error());
+    }
+    hdr = CheckFrameTypeEnabled(header);
+    if (!hdr) {
+        return etl::unexpected(hdr.error());
+    }
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    if (header.can_flags.XLF) {
+        etl::byte_stream_reader xl_length(frame_start + PREAMBLE_SIZE + FORMAT_HEADER_SIZE,
+                                          bytes_available - PREAMBLE_SIZE - FORMAT_HEADER_SIZE, etl::endian::big);
+        auto xl_len = ReadXlPayloadLength(xl_length, header, result.dlc_corrected, payload_len);
+        if (!xl_len) {
+            return etl::unexpected(xl_len.error());
+        }
+    }
+#endif
+
+    const size_t header_end = PREAMBLE_SIZE + header.GetHeaderLength();
+    frame_length = GetWireFrameLength(header, payload_len);
+    if (bytes_available < header_end) {
+        return etl::unexpected(FrameParseError::BufferTooShortForHeader);
+    }
+    if (bytes_available < frame_length) {
+        return etl::unexpected(FrameParseError::BufferTooShortForPayload);
+    }
+
+    // the protected region runs from the format header to the CRC, including any padding
+    FrameCrc crc(payload_len);
+    const size_t crc_start = frame_length - crc.GetSize();
+    crc.Add(etl::span<const uint8_t>(frame_start + PREAMBLE_SIZE, crc_start - PREAMBLE_SIZE));
+    etl::byte_stream_reader received_crc(frame_start + crc_start, crc.GetSize(), etl::endian::big);
+    auto crc_check = ValidateCRC(received_crc, crc);
+    if (!crc_check) {
+        return etl::unexpected(crc_check.error());
+    }
+    stream.skip<uint8_t>(frame_length);
+    return result;
+}
+
+}  // namespace
+
+etl::expected<FrameReadResult, FrameParseError> ReadFrameView(etl::byte_stream_reader& stream, FrameView& out_view) {
+    out_view = FrameView();
+    const uint8_t* frame_start = reinterpret_cast<const uint8_t*>(stream.free_data().data());
+    Frame header;
+    size_t payload_len = 0U;
+    size_t frame_length = 0U;
+    const etl::expected<FrameReadResult, FrameParseError> read =
+        ValidateWireFrame(stream, header, payload_len, frame_length);
+    if (!read) {
+        CountParseError(read.error());
+        return read;
+    }
+    CountFrame(header.can_flags, frame_length, read->dlc_corrected, 0U);
+
+    // it comes out of the reader as const, as the payload does for ReadFrame
+    out_view.wire_ = etl::span<uint8_t>(const_cast<uint8_t*>(frame_start), frame_length);
+    out_view.flags_ = header.can_flags;
+    out_view.payload_length_ = payload_len;
+    return read;
+}
+
+}  // namespace spiopen::frame_reader
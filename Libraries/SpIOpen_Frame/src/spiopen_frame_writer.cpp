@@ -13,30 +13,21 @@ SPDX-License-Identifier: Apache-2.0
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <limits>
 
 #include "spiopen_frame_algorithms.h"
+#include "spiopen_frame_crc.h"
 #include "spiopen_frame_format.h"
 
 namespace spiopen::frame_writer {
 
 using namespace spiopen::format;
 
-namespace impl {
-
-// Checks that the frame is internally valid (data length, etc) and that the buffer can hold the frame.
-etl::expected<void, FrameWriteError> ValidateFrame(etl::byte_stream_writer& stream, const Frame& frame) {
-    size_t payload_len;
-    if (!frame.TryGetPayloadSectionLength(payload_len)) {
-        return etl::unexpected(FrameWriteError::InvalidPayloadLength);
-    }
-    size_t frame_len;
-    if (!frame.TryGetFrameLength(frame_len)) {
-        return etl::unexpected(FrameWriteError::InvalidFrameLength);
-    }
-    if (stream.available_bytes() < frame_len) {
-        return etl::unexpected(FrameWriteError::BufferTooShort);
-    }
+namespace {
 
+// The checks of a frame's type flags against its payload section length and the frame types enabled, shared by
+// ValidateFrame() and the single-pass writers
+etl::expected<void, FrameWriteError> CheckFrameType(const Frame& frame, const size_t payload_len) {
     const bool fdf = frame.can_flags.FDF;
     const bool xlf = frame.can_flags.XLF;
     if (!xlf && !fdf && payload_len > MAX_CC_PAYLOAD_SIZE) {
@@ -52,7 +43,9 @@ etl::expected<void, FrameWriteError> ValidateFrame(etl::byte_stream_writer& stre
     }
 #endif
 #ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
-    if (xlf && payload_len > MAX_XL_PAYLOAD_SIZE) {
+    // the XL data length field holds 11 bits, so the longest XL payload it encodes is one byte short of
+    // MAX_XL_PAYLOAD_SIZE
+    if (xlf && payload_len > SECDED16_DATA_BIT_MASK) {
         return etl::unexpected(FrameWriteError::InvalidPayloadLength);
     }
 #else
@@ -60,10 +53,68 @@ etl::expected<void, FrameWriteError> ValidateFrame(etl::byte_stream_writer& stre
         return etl::unexpected(FrameWriteError::CanXlNotSupported);
     }
 #endif
+#ifndef CONFIG_SPIOPEN_FRAME_WIDE_ALIGNMENT_ENABLE
+    if (frame.can_flags.DWA) {
+        return etl::unexpected(FrameWriteError::WideAlignmentNotSupported);
+    }
+#endif
 
     return {};
 }
 
+// The SECDED-encoded format header of a frame whose payload length has the given DLC, shared by WriteFormatHeader()
+// and the single-pass writers
+uint16_t EncodeFormatHeader(const Frame& frame, const uint8_t dlc) {
+    const uint8_t low = static_cast<uint8_t>(
+        (dlc & HEADER_DLC_MASK) | (frame.can_flags.IDE ? HEADER_IDE_MASK : 0U) |
+        (frame.can_flags.FDF ? HEADER_FDF_MASK : 0U) | (frame.can_flags.XLF ? HEADER_XLF_MASK : 0U) |
+        (frame.can_flags.TTL ? HEADER_TTL_MASK : 0U));
+    const uint8_t high = (frame.can_flags.WA ? HEADER_WA_MASK : 0U) | (frame.can_flags.DWA ? HEADER_DWA_MASK : 0U);
+    const uint16_t raw_header11 = static_cast<uint16_t>(low) | static_cast<uint16_t>(static_cast<uint16_t>(high) << 8U);
+    return algorithms::Secded16Encode11(raw_header11);
+}
+
+// The CAN identifier field with its flag bits in its highest byte: the low 16 bits for a standard identifier, all 32
+// for an extended one
+uint32_t EncodeCanIdentifier(const Frame& frame) {
+    const uint8_t high_byte_flags = (frame.can_flags.RTR ? CID_RTR_MASK : 0U) |
+                                    (frame.can_flags.BRS ? CID_BRS_MASK : 0U) |
+                                    (frame.can_flags.ESI ? CID_ESI_MASK : 0U);
+    if (frame.can_flags.IDE) {
+        return frame.can_identifier | (static_cast<uint32_t>(high_byte_flags) << 24U);
+    }
+    return static_cast<uint16_t>(static_cast<uint16_t>(frame.can_identifier) |
+                                 (static_cast<uint16_t>(high_byte_flags) << 8U));
+}
+
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+// The SECDED-encoded XL data length field
+uint16_t EncodeXlDataLength(const Frame& frame) {
+    return algorithms::Secded16Encode11(static_cast<uint16_t>(frame.payload.size() & 0x07FFU));
+}
+#endif
+
+}  // namespace
+
+namespace impl {
+
+// Checks that the frame is internally valid (data length, etc) and that the buffer can hold the frame.
+etl::expected<void, FrameWriteError> ValidateFrame(etl::byte_stream_writer& stream, const Frame& frame) {
+    size_t payload_len;
+    if (!frame.TryGetPayloadSectionLength(payload_len)) {
+        return etl::unexpected(FrameWriteError::InvalidPayloadLength);
+    }
+    size_t frame_len;
+    if (!frame.TryGetFrameLength(frame_len)) {
+        return etl::unexpected(FrameWriteError::InvalidFrameLength);
+    }
+    if (stream.available_bytes() < frame_len) {
+        return etl::unexpected(FrameWriteError::BufferTooShort);
+    }
+
+    return CheckFrameType(frame, payload_len);
+}
+
 /**
  * @brief Write the preamble bytes to the stream (big-endian word 0xAAAA).
  */
@@ -77,19 +128,11 @@ etl::expected<void, FrameWriteError> WritePreamble(etl::byte_stream_writer& stre
  */
 etl::expected<void, FrameWriteError> WriteFormatHeader(etl::byte_stream_writer& stream, const Frame& frame) {
     uint8_t dlc_low_nibble = 0;
-    if (!TryGetDlcFromPayloadLength(frame.payload.size(), dlc_low_nibble)) {
+    // XL payloads longer than an FD payload have no DLC; their length is carried by the XL data length field instead
+    if (!TryGetDlcFromPayloadLength(frame.payload.size(), dlc_low_nibble) && !frame.can_flags.XLF) {
         return etl::unexpected(FrameWriteError::InvalidPayloadLength);
     }
-    const uint8_t low = static_cast<uint8_t>(
-        (dlc_low_nibble & HEADER_DLC_MASK) | (frame.can_flags.IDE ? HEADER_IDE_MASK : 0U) |
-        (frame.can_flags.FDF ? HEADER_FDF_MASK : 0U) | (frame.can_flags.XLF ? HEADER_XLF_MASK : 0U) |
-        (frame.can_flags.TTL ? HEADER_TTL_MASK : 0U));
-    const uint8_t high = frame.can_flags.WA ? HEADER_WA_MASK : 0U;
-
-    const uint16_t raw_header11 =
-        static_cast<uint16_t>(low) | static_cast<uint16_t>((static_cast<uint16_t>(high & HEADER_WA_MASK)) << 8U);
-    const uint16_t encoded_header = algorithms::Secded16Encode11(raw_header11);
-
+    const uint16_t encoded_header = EncodeFormatHeader(frame, dlc_low_nibble);
     return stream.write(encoded_header) ? etl::expected<void, FrameWriteError>()
                                         : etl::unexpected(FrameWriteError::BufferTooShort);
 }
@@ -98,20 +141,13 @@ etl::expected<void, FrameWriteError> WriteFormatHeader(etl::byte_stream_writer&
  * @brief Write the CAN identifier (standard or extended) and flag bits to the stream (big-endian).
  */
 etl::expected<void, FrameWriteError> WriteCanIdentifier(etl::byte_stream_writer& stream, const Frame& frame) {
-    const size_t cid_size = frame.GetCanIdLength();
-    uint32_t id32 = frame.can_identifier;
-    const uint8_t high_byte_flags = (frame.can_flags.RTR ? CID_RTR_MASK : 0U) |
-                                    (frame.can_flags.BRS ? CID_BRS_MASK : 0U) |
-                                    (frame.can_flags.ESI ? CID_ESI_MASK : 0U);
-
+    const uint32_t id32 = EncodeCanIdentifier(frame);
     if (frame.can_flags.IDE) {
-        id32 |= static_cast<uint32_t>(high_byte_flags) << 24U;
         return stream.write(id32) ? etl::expected<void, FrameWriteError>()
                                   : etl::unexpected(FrameWriteError::BufferTooShort);
     } else {
-        const uint16_t id16 = static_cast<uint16_t>(id32) | (static_cast<uint16_t>(high_byte_flags) << 8U);
-        return stream.write(id16) ? etl::expected<void, FrameWriteError>()
-                                  : etl::unexpected(FrameWriteError::BufferTooShort);
+        return stream.write(static_cast<uint16_t>(id32)) ? etl::expected<void, FrameWriteError>()
+                                                         : etl::unexpected(FrameWriteError::BufferTooShort);
     }
 }
 
@@ -120,8 +156,7 @@ etl::expected<void, FrameWriteError> WriteCanIdentifier(etl::byte_stream_writer&
  * @brief Write the XL data length (SECDED) and control field to the stream (big-endian multi-byte values).
  */
 etl::expected<void, FrameWriteError> WriteXlDataAndControl(etl::byte_stream_writer& stream, const Frame& frame) {
-    const uint16_t encoded_xl_dlc = algorithms::Secded16Encode11(static_cast<uint16_t>(frame.payload.size() & 0x07FFU));
-    bool wrote_all = true;
+    const uint16_t encoded_xl_dlc = EncodeXlDataLength(frame);
     // short circuit evaluation to write all the bytes
     return (stream.write(encoded_xl_dlc) && stream.write(frame.xl_control.payload_type) &&
             stream.write(frame.xl_control.virtual_can_network_id) && stream.write(frame.xl_control.addressing_field))
@@ -165,18 +200,24 @@ etl::expected<void, FrameWriteError> WritePayload(etl::byte_stream_writer& strea
 }
 
 /**
- * @brief Write word-alignment padding byte to the stream if WA flag is set and current length is odd.
+ * @brief Write the alignment padding bytes to the stream if the WA or DWA flag is set, so the frame from its preamble
+ * to its CRC is a multiple of the frame's alignment. The padding depends on the frame alone, not on where the frame
+ * starts in the stream.
  */
 etl::expected<void, FrameWriteError> WriteFramePadding(etl::byte_stream_writer& stream, const Frame& frame) {
-    if (!frame.can_flags.WA) {
-        return {};
+    size_t section_length;
+    if (!frame.TryGetPayloadSectionLength(section_length)) {
+        return etl::unexpected(FrameWriteError::InvalidPayloadLength);
     }
-    const size_t current_length = stream.size_bytes() - PREAMBLE_SIZE;
-    if (etl::is_even(current_length)) {
-        return {};
+    const size_t unpadded_length =
+        PREAMBLE_SIZE + frame.GetHeaderLength() + section_length + GetCrcLengthFromPayloadLength(section_length);
+    const size_t padding_length = GetAlignmentPaddingLength(unpadded_length, frame.GetAlignment());
+    for (size_t i = 0U; i < padding_length; ++i) {
+        if (!stream.write(static_cast<uint8_t>(0U))) {
+            return etl::unexpected(FrameWriteError::BufferTooShort);
+        }
     }
-    return stream.write(static_cast<uint8_t>(0U)) ? etl::expected<void, FrameWriteError>()
-                                                  : etl::unexpected(FrameWriteError::BufferTooShort);
+    return {};
 }
 
 /**
@@ -188,81 +229,322 @@ etl::expected<void, FrameWriteError> WriteCrc(etl::byte_stream_writer& stream, c
     if (!frame.TryGetPayloadSectionLength(section_length)) {
         return etl::unexpected(FrameWriteError::InvalidPayloadLength);
     }
-    const size_t crc_size = GetCrcLengthFromPayloadLength(section_length);
+    FrameCrc crc(section_length);
+    crc.Add(crc_region);
+    const bool wrote_crc =
+        crc.IsLong() ? stream.write(crc.GetValue()) : stream.write(static_cast<uint16_t>(crc.GetValue()));
+    return wrote_crc ? etl::expected<void, FrameWriteError>() : etl::unexpected(FrameWriteError::BufferTooShort);
+}
+
+}  // namespace impl
+
+using namespace spiopen::frame_writer::impl;
 
-    if (crc_size == LONG_CRC_SIZE) {
-        const uint32_t v = algorithms::ComputeCrc32(crc_region);
-        return stream.write(v) ? etl::expected<void, FrameWriteError>()
-                               : etl::unexpected(FrameWriteError::BufferTooShort);
+namespace {
+
+// Where each part of a frame goes, worked out once per frame
+struct FrameLayout {
+    uint8_t dlc;                    // DLC for the format header (0 for XL payloads longer than an FD payload)
+    bool has_dlc;                   // false if the payload length has no DLC (only valid for XL frames)
+    size_t payload_section_length;  // payload plus FD DLC padding
+    size_t header_end;              // offset of the payload from the start of the preamble
+    size_t crc_position;            // offset of the CRC field; the WA padding byte, if any, is just before it
+    size_t frame_length;            // preamble to CRC, including padding
+};
+
+// Work out where each field goes; false if the payload length has no payload section length
+bool TryGetFrameLayout(const Frame& frame, FrameLayout& layout) {
+    if (!frame.TryGetPayloadSectionLength(layout.payload_section_length)) {
+        return false;
     }
-    if (crc_size == SHORT_CRC_SIZE) {
-        const uint16_t v = algorithms::ComputeCrc16(crc_region);
-        return stream.write(v) ? etl::expected<void, FrameWriteError>()
-                               : etl::unexpected(FrameWriteError::BufferTooShort);
+    layout.header_end = PREAMBLE_SIZE + frame.GetHeaderLength();
+    layout.crc_position = layout.header_end + layout.payload_section_length;
+    const size_t crc_size = GetCrcLengthFromPayloadLength(layout.payload_section_length);
+    layout.crc_position += GetAlignmentPaddingLength(layout.crc_position + crc_size, frame.GetAlignment());
+    layout.frame_length = layout.crc_position + crc_size;
+    layout.dlc = 0U;
+    // XL payloads longer than an FD payload have no DLC; their length is carried by the XL data length field instead
+    layout.has_dlc = TryGetDlcFromPayloadLength(frame.payload.size(), layout.dlc);
+    return true;
+}
+
+// The checks of ValidateFrame() and WriteFormatHeader(), in the same order, with the layout they imply
+etl::expected<void, FrameWriteError> GetFrameLayout(const Frame& frame, const size_t available_bytes,
+                                                    FrameLayout& layout) {
+    if (!TryGetFrameLayout(frame, layout)) {
+        return etl::unexpected(FrameWriteError::InvalidPayloadLength);
+    }
+    if (available_bytes < layout.frame_length) {
+        return etl::unexpected(FrameWriteError::BufferTooShort);
     }
-    return etl::unexpected(FrameWriteError::InvalidPayloadLength);  // should never happen
+
+    auto type_checked = CheckFrameType(frame, layout.payload_section_length);
+    if (!type_checked) {
+        return type_checked;
+    }
+    if (!layout.has_dlc && !frame.can_flags.XLF) {
+        return etl::unexpected(FrameWriteError::InvalidPayloadLength);
+    }
+    return {};
 }
 
-}  // namespace impl
+inline uint8_t* StoreBigEndian16(uint8_t* out, const uint16_t value) {
+    out[0] = static_cast<uint8_t>(value >> 8U);
+    out[1] = static_cast<uint8_t>(value);
+    return out + 2U;
+}
 
-using namespace spiopen::frame_writer::impl;
+inline uint8_t* StoreBigEndian32(uint8_t* out, const uint32_t value) {
+    out[0] = static_cast<uint8_t>(value >> 24U);
+    out[1] = static_cast<uint8_t>(value >> 16U);
+    out[2] = static_cast<uint8_t>(value >> 8U);
+    out[3] = static_cast<uint8_t>(value);
+    return out + 4U;
+}
+
+// Store the preamble and header fields with the encoders the field writers above use; returns the end of the header
+uint8_t* StoreHeader(uint8_t* out, const Frame& frame, const FrameLayout& layout) {
+    out[0] = PREAMBLE_BYTE;
+    out[1] = PREAMBLE_BYTE;
+    out += PREAMBLE_SIZE;
+    out = StoreBigEndian16(out, EncodeFormatHeader(frame, layout.dlc));
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    if (frame.can_flags.XLF) {
+        out = StoreBigEndian16(out, EncodeXlDataLength(frame));
+        *out++ = frame.xl_control.payload_type;
+        *out++ = frame.xl_control.virtual_can_network_id;
+        out = StoreBigEndian32(out, frame.xl_control.addressing_field);
+    }
+#endif
+    const uint32_t can_identifier = EncodeCanIdentifier(frame);
+    if (frame.can_flags.IDE) {
+        out = StoreBigEndian32(out, can_identifier);
+    } else {
+        out = StoreBigEndian16(out, static_cast<uint16_t>(can_identifier));
+    }
+    if (frame.can_flags.TTL) {
+        *out++ = frame.time_to_live;
+    }
+    return out;
+}
+
+// Store everything after the header in a single pass: the payload is copied in cache-sized chunks that are folded into
+// the CRC as they are copied, so the frame is not read back for the CRC, then the padding and the CRC are stored
+void StorePayloadAndCrc(uint8_t* const out, const uint8_t* const payload, const size_t payload_size,
+                        const size_t header_end, const size_t crc_position, FrameCrc& crc) {
+    static constexpr size_t crc_chunk_size = 64U;  // as CopyFromBitSlippedBuffer in the reader
+    for (size_t done = 0U; done < payload_size;) {
+        const size_t chunk = (payload_size - done < crc_chunk_size) ? payload_size - done : crc_chunk_size;
+        std::memcpy(out + header_end + done, payload + done, chunk);
+        crc.Add(etl::span<const uint8_t>(out + header_end + done, chunk));
+        done += chunk;
+    }
+    // FD DLC padding and WA padding are zeros, and protected by the CRC
+    const size_t padding_start = header_end + payload_size;
+    if (crc_position > padding_start) {
+        std::memset(out + padding_start, 0, crc_position - padding_start);
+        crc.Add(etl::span<const uint8_t>(out + padding_start, crc_position - padding_start));
+    }
+
+    const uint32_t crc_value = crc.GetValue();
+    if (crc.IsLong()) {
+        StoreBigEndian32(out + crc_position, crc_value);
+    } else {
+        StoreBigEndian16(out + crc_position, static_cast<uint16_t>(crc_value));
+    }
+}
+
+// Store a frame that has passed GetFrameLayout()
+void StoreFrame(uint8_t* const out, const Frame& frame, const FrameLayout& layout) {
+    StoreHeader(out, frame, layout);
+    FrameCrc crc(layout.payload_section_length);
+    crc.Add(etl::span<const uint8_t>(out + PREAMBLE_SIZE, layout.header_end - PREAMBLE_SIZE));
+    StorePayloadAndCrc(out, frame.payload.data(), frame.payload.size(), layout.header_end, layout.crc_position, crc);
+}
+
+// Round position up to a multiple of alignment (1 or more)
+inline size_t AlignUp(const size_t position, const size_t alignment) {
+    if ((alignment & (alignment - 1U)) == 0U) {  // powers of two, the usual DMA word sizes, without a division
+        return (position + alignment - 1U) & ~(alignment - 1U);
+    }
+    const size_t remainder = position % alignment;
+    return (remainder == 0U) ? position : position + (alignment - remainder);
+}
+
+}  // namespace
 
 // --- Public API ---
 etl::expected<void, FrameWriteError> WriteFrame(etl::byte_stream_writer& stream, const Frame& frame) {
-    auto valid = ValidateFrame(stream, frame);
+    FrameLayout layout;
+    auto valid = GetFrameLayout(frame, stream.available_bytes(), layout);
     if (!valid) {
         return etl::unexpected(valid.error());
     }
+    StoreFrame(reinterpret_cast<uint8_t*>(stream.free_data().data()), frame, layout);
+    stream.skip<uint8_t>(layout.frame_length);
+    return {};
+}
 
-    size_t start_position = stream.used_data().size();
+etl::expected<void, FrameWriteError> PrepareFrameTemplate(const Frame& frame, CyclicFrameTemplate& frame_template) {
+    frame_template.frame_length_ = 0U;
+    FrameLayout layout;
+    auto valid = GetFrameLayout(frame, std::numeric_limits<size_t>::max(), layout);
+    if (!valid) {
+        return etl::unexpected(valid.error());
+    }
+    uint8_t* const header = frame_template.header_.data();
+    StoreHeader(header, frame, layout);
+    FrameCrc crc(layout.payload_section_length);
+    crc.Add(etl::span<const uint8_t>(header + PREAMBLE_SIZE, layout.header_end - PREAMBLE_SIZE));
+    frame_template.header_crc_ = crc;
+    frame_template.header_length_ = layout.header_end;
+    frame_template.payload_size_ = frame.payload.size();
+    frame_template.crc_position_ = layout.crc_position;
+    frame_template.frame_length_ = layout.frame_length;
+    return {};
+}
 
-    auto pre = WritePreamble(stream);
-    if (!pre) {
-        return etl::unexpected(pre.error());
+// The header is copied and the CRC carries on from the header's, so only the payload, padding and CRC are worked on
+etl::expected<void, FrameWriteError> WriteFrame(etl::byte_stream_writer& stream,
+                                                const CyclicFrameTemplate& frame_template,
+                                                const etl::span<const uint8_t>& payload) {
+    if (frame_template.frame_length_ == 0U) {
+        return etl::unexpected(FrameWriteError::InvalidFrameLength);
     }
+    if (payload.size() != frame_template.payload_size_) {
+        return etl::unexpected(FrameWriteError::InvalidPayloadLength);
+    }
+    if (stream.available_bytes() < frame_template.frame_length_) {
+        return etl::unexpected(FrameWriteError::BufferTooShort);
+    }
+    uint8_t* const out = reinterpret_cast<uint8_t*>(stream.free_data().data());
+    std::memcpy(out, frame_template.header_.data(), frame_template.header_length_);
+    FrameCrc crc = frame_template.header_crc_;
+    StorePayloadAndCrc(out, payload.data(), payload.size(), frame_template.header_length_,
+                       frame_template.crc_position_, crc);
+    stream.skip<uint8_t>(frame_template.frame_length_);
+    return {};
+}
 
-    auto hdr = WriteFormatHeader(stream, frame);
-    if (!hdr) {
-        return etl::unexpected(hdr.error());
+// The header and trailer are stored as WriteFrame() stores them; the payload is only read, for the CRC
+etl::expected<void, FrameWriteError> WriteFrameSegments(const Frame& frame, FrameSegments& segments) {
+    segments.segment_count_ = 0U;
+    segments.frame_length_ = 0U;
+    FrameLayout layout;
+    auto valid = GetFrameLayout(frame, std::numeric_limits<size_t>::max(), layout);
+    if (!valid) {
+        return etl::unexpected(valid.error());
     }
 
-#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
-    if (frame.can_flags.XLF) {
-        auto xl = WriteXlDataAndControl(stream, frame);
-        if (!xl) {
-            return etl::unexpected(xl.error());
-        }
+    uint8_t* const header = segments.header_.data();
+    StoreHeader(header, frame, layout);
+    FrameCrc crc(layout.payload_section_length);
+    crc.Add(etl::span<const uint8_t>(header + PREAMBLE_SIZE, layout.header_end - PREAMBLE_SIZE));
+    const size_t payload_size = frame.payload.size();
+    crc.Add(etl::span<const uint8_t>(frame.payload.data(), payload_size));
+
+    // FD DLC padding and WA padding are zeros, and protected by the CRC
+    uint8_t* const trailer = segments.trailer_.data();
+    const size_t padding_size = layout.crc_position - layout.header_end - payload_size;
+    if (padding_size > 0U) {
+        std::memset(trailer, 0, padding_size);
+        crc.Add(etl::span<const uint8_t>(trailer, padding_size));
     }
-#endif
+    const uint32_t crc_value = crc.GetValue();
+    const uint8_t* const trailer_end = crc.IsLong()
+                                           ? StoreBigEndian32(trailer + padding_size, crc_value)
+                                           : StoreBigEndian16(trailer + padding_size, static_cast<uint16_t>(crc_value));
+
+    segments.segments_[segments.segment_count_++] = FrameSegment{header, layout.header_end};
+    if (payload_size > 0U) {
+        segments.segments_[segments.segment_count_++] = FrameSegment{frame.payload.data(), payload_size};
+    }
+    segments.segments_[segments.segment_count_++] = FrameSegment{trailer, static_cast<size_t>(trailer_end - trailer)};
+    segments.frame_length_ = layout.frame_length;
+    return {};
+}
 
-    auto cid = WriteCanIdentifier(stream, frame);
-    if (!cid) {
-        return etl::unexpected(cid.error());
+etl::expected<size_t, FrameWriteError> GetBatchLength(const etl::span<const Frame>& frames,
+                                                      const BatchWriteOptions& options) {
+    const size_t alignment = (options.frame_alignment == 0U) ? 1U : options.frame_alignment;
+    size_t position = 0U;
+    for (size_t i = 0U; i < frames.size(); ++i) {
+        FrameLayout layout;
+        auto valid = GetFrameLayout(frames[i], std::numeric_limits<size_t>::max(), layout);
+        if (!valid) {
+            return etl::unexpected(valid.error());
+        }
+        position = AlignUp((i == 0U) ? 0U : position + options.inter_frame_gap, alignment) + layout.frame_length;
     }
+    return position;
+}
 
-    auto ttl = WriteTimeToLive(stream, frame);
-    if (!ttl) {
-        return etl::unexpected(ttl.error());
+// Each frame is checked as it is written, against the space left after the frames before it, and the stream is only
+// moved on once the whole batch is written
+etl::expected<size_t, FrameWriteError> WriteFrames(etl::byte_stream_writer& stream,
+                                                   const etl::span<const Frame>& frames,
+                                                   const etl::span<size_t>& frame_offsets,
+                                                   const BatchWriteOptions& options) {
+    if (frame_offsets.size() < frames.size()) {
+        return etl::unexpected(FrameWriteError::BufferTooShort);
+    }
+    const size_t alignment = (options.frame_alignment == 0U) ? 1U : options.frame_alignment;
+    const size_t available_bytes = stream.available_bytes();
+    uint8_t* const out = reinterpret_cast<uint8_t*>(stream.free_data().data());
+    size_t position = 0U;
+    for (size_t i = 0U; i < frames.size(); ++i) {
+        const size_t offset = AlignUp((i == 0U) ? 0U : position + options.inter_frame_gap, alignment);
+        FrameLayout layout;
+        auto valid = GetFrameLayout(frames[i], (offset < available_bytes) ? available_bytes - offset : 0U, layout);
+        if (!valid) {
+            return etl::unexpected(valid.error());
+        }
+        if (offset > position) {
+            std::memset(out + position, options.idle_byte, offset - position);
+        }
+        StoreFrame(out + offset, frames[i], layout);
+        frame_offsets[i] = offset;
+        position = offset + layout.frame_length;
     }
+    stream.skip<uint8_t>(position);
+    return position;
+}
 
-    auto pay = WritePayload(stream, frame);
-    if (!pay) {
-        return etl::unexpected(pay.error());
+etl::expected<bool, FrameWriteError> DecrementTimeToLiveInPlace(etl::span<uint8_t> encoded_frame, Frame& frame) {
+    if (!frame.can_flags.TTL) {
+        return false;
     }
+    size_t payload_section_length = 0U;
+    size_t frame_length = 0U;
+    if (!frame.TryGetPayloadSectionLength(payload_section_length) || !frame.TryGetFrameLength(frame_length)) {
+        return etl::unexpected(FrameWriteError::InvalidPayloadLength);
+    }
+    if (encoded_frame.size() < frame_length) {
+        return etl::unexpected(FrameWriteError::BufferTooShort);
+    }
+
+    // the TTL is the last header field, the CRC the last field of the frame
+    const size_t ttl_position = PREAMBLE_SIZE + frame.GetHeaderLength() - TIME_TO_LIVE_SIZE;
+    const bool is_long_crc = GetCrcLengthFromPayloadLength(payload_section_length) == LONG_CRC_SIZE;
+    const size_t crc_size = is_long_crc ? LONG_CRC_SIZE : SHORT_CRC_SIZE;
+    const size_t crc_position = frame_length - crc_size;
 
-    auto pad = WriteFramePadding(stream, frame);
-    if (!pad) {
-        return etl::unexpected(pad.error());
+    const uint8_t old_time_to_live = encoded_frame[ttl_position];
+    if (old_time_to_live == 0U) {
+        frame.time_to_live = 0U;
+        return true;
     }
-    auto crc_region = stream.used_data().subspan(PREAMBLE_SIZE + start_position);
-    auto crc =
-        WriteCrc(stream, frame,
-                 etl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(crc_region.data()), crc_region.size()));
-    if (!crc) {
-        return etl::unexpected(crc.error());
+    const uint8_t new_time_to_live = static_cast<uint8_t>(old_time_to_live - 1U);
+    encoded_frame[ttl_position] = new_time_to_live;
+
+    const uint32_t crc_delta = FrameCrc::GetByteChangeDelta(
+        is_long_crc, static_cast<uint8_t>(old_time_to_live ^ new_time_to_live), crc_position - ttl_position - 1U);
+    for (size_t i = 0U; i < crc_size; ++i) {  // the CRC is stored big-endian
+        encoded_frame[crc_position + i] ^= static_cast<uint8_t>(crc_delta >> (8U * (crc_size - 1U - i)));
     }
 
-    return {};
+    frame.time_to_live = new_time_to_live;
+    return (new_time_to_live == 0U);
 }
 
 }  // namespace spiopen::frame_writer
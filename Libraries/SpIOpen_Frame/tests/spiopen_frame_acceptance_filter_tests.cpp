@@ -0,0 +1,146 @@
+#include <etl/byte_stream.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "spiopen_frame.h"
+#include "spiopen_frame_acceptance_filter.h"
+#include "spiopen_frame_format.h"
+#include "spiopen_frame_reader.h"
+#include "spiopen_frame_test_helpers.h"
+#include "spiopen_frame_writer.h"
+
+using namespace spiopen;
+using namespace spiopen::format;
+using namespace spiopen::frame_reader;
+using namespace spiopen::test_helpers;
+
+TEST(SpIOpen_AcceptanceFilter, Accepts) {
+    AcceptanceFilter filter;
+    EXPECT_FALSE(filter.Accepts(0x123U, false)) << "an empty filter accepts nothing";
+    EXPECT_FALSE(filter.Accepts(0x123U, true));
+
+    filter.AddStandardId(0x123U);
+    filter.AddStandardId(0x7FFU);
+    EXPECT_TRUE(filter.Accepts(0x123U, false));
+    EXPECT_TRUE(filter.Accepts(0x7FFU, false));
+    EXPECT_FALSE(filter.Accepts(0x124U, false));
+    EXPECT_FALSE(filter.Accepts(0x123U, true)) << "standard IDs do not match extended frames";
+
+    // fill the extended ID set, with identifiers that share their low bits
+    for (uint32_t i = 0U; i < AcceptanceFilter::MAX_EXTENDED_IDS; ++i) {
+        ASSERT_TRUE(filter.AddExtendedId(0x1000000U + (i << 16U)));
+    }
+    EXPECT_TRUE(filter.AddExtendedId(0x1000000U)) << "adding an ID twice does not use a slot";
+    EXPECT_FALSE(filter.AddExtendedId(0x1ABCDEFU)) << "the set is full";
+    for (uint32_t i = 0U; i < AcceptanceFilter::MAX_EXTENDED_IDS; ++i) {
+        EXPECT_TRUE(filter.Accepts(0x1000000U + (i << 16U), true));
+        EXPECT_FALSE(filter.Accepts(0x1000001U + (i << 16U), true));
+    }
+    EXPECT_FALSE(filter.Accepts(0x1ABCDEFU, true));
+    EXPECT_FALSE(filter.Accepts(0x000U, false));
+
+    // a range of standard IDs (0x180 to 0x1FF) and every extended ID with the top bits 0x1F
+    ASSERT_TRUE(filter.AddMask(0x180U, 0x780U, false));
+    ASSERT_TRUE(filter.AddMask(0x1F000000U, 0x1F000000U, true));
+    EXPECT_TRUE(filter.Accepts(0x180U, false));
+    EXPECT_TRUE(filter.Accepts(0x1FFU, false));
+    EXPECT_FALSE(filter.Accepts(0x200U, false));
+    EXPECT_FALSE(filter.Accepts(0x1FFU, true)) << "the standard range does not match extended frames";
+    EXPECT_TRUE(filter.Accepts(0x1F123456U, true));
+    EXPECT_FALSE(filter.Accepts(0x0F123456U, true));
+    for (size_t i = 2U; i < AcceptanceFilter::MAX_MASK_FILTERS; ++i) {
+        ASSERT_TRUE(filter.AddMask(0U, 0x7FFU, false));
+    }
+    EXPECT_FALSE(filter.AddMask(0U, 0U, false)) << "the mask/code pairs are full";
+
+    filter.Clear();
+    EXPECT_FALSE(filter.Accepts(0x123U, false));
+    EXPECT_FALSE(filter.Accepts(0x1000000U, true));
+    EXPECT_FALSE(filter.Accepts(0x180U, false));
+    ASSERT_TRUE(filter.AddMask(0U, 0U, true));
+    EXPECT_TRUE(filter.Accepts(0x1ABCDEFU, true)) << "a zero mask accepts every ID of its type";
+    EXPECT_FALSE(filter.Accepts(0x123U, false));
+}
+
+TEST(SpIOpen_AcceptanceFilter, ReaderSkipsRejectedFrames) {
+    uint8_t payload[300];
+    for (size_t i = 0U; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+    // a stream of frames for other nodes around one for this node, which the filter accepts
+    struct StreamFrame {
+        uint32_t can_identifier;
+        bool extended;
+        size_t payload_size;
+        bool word_aligned;
+    };
+    std::vector<StreamFrame> frames = {{0x100U, false, 8U, false},
+                                       {0x123U, false, 5U, true},
+                                       {0x1ABCDEFU, true, 3U, true},
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
+                                       {0x101U, false, 64U, false},
+#endif
+                                       {0x1000000U, true, 0U, false}};
+    AcceptanceFilter filter;
+    filter.AddStandardId(0x123U);
+    filter.AddExtendedId(0x1000000U);
+
+    std::vector<uint8_t> wire;
+    for (const StreamFrame& stream_frame : frames) {
+        Frame frame{};
+        frame.can_identifier = stream_frame.can_identifier;
+        frame.can_flags.IDE = stream_frame.extended;
+        frame.can_flags.WA = stream_frame.word_aligned;
+        frame.can_flags.FDF = (stream_frame.payload_size > MAX_CC_PAYLOAD_SIZE) ? 1 : 0;
+        frame.payload = etl::span<uint8_t>(payload, stream_frame.payload_size);
+        ASSERT_TRUE(AppendEncodedFrame(frame, wire));
+    }
+
+    for (uint8_t bit_slip_count = 0U; bit_slip_count < 8U; ++bit_slip_count) {
+        // slip the whole stream, one byte longer
+        const std::vector<uint8_t> slipped = BitSlip(wire, bit_slip_count);
+        etl::byte_stream_reader input(slipped.data(), slipped.size(), etl::endian::big);
+        for (const StreamFrame& stream_frame : frames) {
+            uint8_t destination[MAX_CAN_FD_FRAME_SIZE];
+            std::memset(destination, 0xEE, sizeof(destination));
+            Frame frame{};
+            auto ret = ReadAndCopyFrame(input, etl::span<uint8_t>(destination, sizeof(destination)), frame,
+                                        bit_slip_count, filter);
+            EXPECT_EQ(frame.can_identifier, stream_frame.can_identifier);
+            if (filter.Accepts(stream_frame.can_identifier, stream_frame.extended)) {
+                ASSERT_TRUE(ret) << "slip " << static_cast<int>(bit_slip_count);
+                EXPECT_EQ(frame.payload.size(), stream_frame.payload_size);
+                continue;
+            }
+            ASSERT_FALSE(ret);
+            EXPECT_EQ(ret.error(), FrameParseError::FrameFiltered);
+            EXPECT_TRUE(frame.payload.empty());
+            EXPECT_EQ(destination[PREAMBLE_SIZE + frame.GetHeaderLength()], 0xEEU)
+                << "the payload of a rejected frame is not copied";
+        }
+        EXPECT_EQ(input.available_bytes(), 1U) << "every frame was read or skipped, up to the extra byte";
+    }
+
+    // ReadFrame skips the same frames in place
+    etl::byte_stream_reader stream(wire.data(), wire.size(), etl::endian::big);
+    for (const StreamFrame& stream_frame : frames) {
+        Frame frame{};
+        auto ret = ReadFrame(stream, frame, filter);
+        EXPECT_EQ(ret.has_value(), filter.Accepts(stream_frame.can_identifier, stream_frame.extended));
+        if (!ret) {
+            EXPECT_EQ(ret.error(), FrameParseError::FrameFiltered);
+        }
+    }
+    EXPECT_EQ(stream.available_bytes(), 0U);
+
+    // a rejected frame that is not all in the buffer yet cannot be skipped
+    etl::byte_stream_reader truncated(wire.data(), 8U, etl::endian::big);
+    Frame frame{};
+    auto ret = ReadFrame(truncated, frame, filter);
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(ret.error(), FrameParseError::BufferTooShortForPayload);
+}
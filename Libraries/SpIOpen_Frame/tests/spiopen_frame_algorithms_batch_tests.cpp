@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "etl/span.h"
+#include "spiopen_frame_algorithms.h"
+
+using namespace spiopen::algorithms;
+
+static bool MaskBit(const std::vector<uint32_t>& mask, size_t index) {
+    return ((mask[index / 32U] >> (index % 32U)) & 1U) != 0U;
+}
+
+TEST(SpIOpen_AlgorithmsBatch, EncodeMatchesSingleWord) {
+    // every 11-bit value plus a few with stray high bits, and an odd count so the scalar tail is used too
+    std::vector<uint16_t> raw;
+    for (uint16_t raw11 = 0U; raw11 <= 0x07FFU; ++raw11) {
+        raw.push_back(raw11);
+    }
+    raw.push_back(0xF800U);
+    raw.push_back(0xFFFFU);
+    raw.push_back(0x8123U);
+    std::vector<uint16_t> encoded(raw.size());
+
+    ASSERT_TRUE(Secded16Encode11Batch(etl::span<const uint16_t>(raw.data(), raw.size()),
+                                      etl::span<uint16_t>(encoded.data(), encoded.size())));
+    for (size_t i = 0U; i < raw.size(); ++i) {
+        EXPECT_EQ(encoded[i], Secded16Encode11(raw[i])) << "batch encode of word " << i;
+    }
+}
+
+TEST(SpIOpen_AlgorithmsBatch, DecodeMatchesSingleWord) {
+    // runs of clean words with single and double bit errors sprinkled in at lane and mask word boundaries
+    std::vector<uint16_t> received;
+    for (size_t i = 0U; i < 531U; ++i) {
+        uint16_t word = Secded16Encode11(static_cast<uint16_t>((i * 37U) & 0x07FFU));
+        if ((i % 13U) == 0U) {
+            word ^= static_cast<uint16_t>(1U << (i % 16U));
+        } else if ((i % 29U) == 0U) {
+            word ^= static_cast<uint16_t>((1U << (i % 16U)) | (1U << ((i + 5U) % 16U)));
+        }
+        received.push_back(word);
+    }
+    received[31U] ^= 0x8000U;  // overall parity only
+    received[32U] ^= 0x0001U;
+    std::vector<uint16_t> data(received.size());
+    std::vector<uint32_t> corrected(Secded16BatchMaskWords(received.size()), 0xFFFFFFFFU);
+    std::vector<uint32_t> uncorrectable(Secded16BatchMaskWords(received.size()), 0xFFFFFFFFU);
+
+    ASSERT_TRUE(Secded16Decode11Batch(etl::span<const uint16_t>(received.data(), received.size()),
+                                      etl::span<uint16_t>(data.data(), data.size()),
+                                      etl::span<uint32_t>(corrected.data(), corrected.size()),
+                                      etl::span<uint32_t>(uncorrectable.data(), uncorrectable.size())));
+    for (size_t i = 0U; i < received.size(); ++i) {
+        const Secded16DecodeResult expected = Secded16Decode11(received[i]);
+        if (!expected.uncorrectable) {
+            EXPECT_EQ(data[i], expected.data11) << "batch decode data of word " << i;
+        }
+        EXPECT_EQ(MaskBit(corrected, i), expected.corrected) << "batch decode corrected flag of word " << i;
+        EXPECT_EQ(MaskBit(uncorrectable, i), expected.uncorrectable) << "batch decode uncorrectable flag of word " << i;
+    }
+    // bits past the last word are cleared
+    EXPECT_EQ(corrected.back() >> (received.size() % 32U), 0U);
+    EXPECT_EQ(uncorrectable.back() >> (received.size() % 32U), 0U);
+}
+
+TEST(SpIOpen_AlgorithmsBatch, RejectsShortOutputs) {
+    uint16_t words[40] = {0};
+    uint16_t out[40] = {0};
+    uint32_t corrected[2] = {0};
+    uint32_t uncorrectable[2] = {0};
+    const etl::span<const uint16_t> input(words, 40U);
+
+    EXPECT_FALSE(Secded16Encode11Batch(input, etl::span<uint16_t>(out, 39U))) << "encode output too short";
+    EXPECT_FALSE(Secded16Decode11Batch(input, etl::span<uint16_t>(out, 39U), etl::span<uint32_t>(corrected, 2U),
+                                       etl::span<uint32_t>(uncorrectable, 2U)))
+        << "decode data output too short";
+    EXPECT_FALSE(Secded16Decode11Batch(input, etl::span<uint16_t>(out, 40U), etl::span<uint32_t>(corrected, 1U),
+                                       etl::span<uint32_t>(uncorrectable, 2U)))
+        << "decode mask output too short";
+    EXPECT_TRUE(Secded16Decode11Batch(etl::span<const uint16_t>(), etl::span<uint16_t>(), etl::span<uint32_t>(),
+                                      etl::span<uint32_t>()))
+        << "empty batch";
+}
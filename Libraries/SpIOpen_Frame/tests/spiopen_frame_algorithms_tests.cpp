@@ -3,6 +3,8 @@
 #include <cstddef>
 #include <cstdint>
 
+#include "etl/crc16_ccitt.h"
+#include "etl/crc32_mpeg2.h"
 #include "etl/span.h"
 #include "spiopen_frame_algorithms.h"
 
@@ -18,6 +20,66 @@ TEST(SpIOpen_Algorithms, CrcEncodingAccuracy) {
     EXPECT_EQ(ComputeCrc32(example_data_to_crc_span), expected_crc32) << "CRC32 encoding accuracy";
 }
 
+TEST(SpIOpen_Algorithms, CrcMatchesReferenceForAllFrameLengths) {
+    // Every backend must be bit-exact with the ETL byte-wise CRCs used by the default backend. Cover every length a
+    // frame can produce and a few start alignments, since accelerated backends process words/blocks plus a tail.
+    static constexpr size_t kMaxLength = 2048U;
+    static constexpr size_t kMaxAlignment = 8U;
+    static uint8_t data[kMaxLength + kMaxAlignment];
+    uint32_t lfsr = 0xACE1ACE1U;
+    for (uint8_t& byte : data) {
+        lfsr = (lfsr >> 1U) ^ (-(lfsr & 1U) & 0xD0000001U);
+        byte = static_cast<uint8_t>(lfsr);
+    }
+
+    for (size_t alignment = 0U; alignment < kMaxAlignment; alignment += 3U) {
+        for (size_t length = 0U; length <= kMaxLength; ++length) {
+            const etl::span<const uint8_t> region(data + alignment, length);
+            etl::crc16_ccitt reference16;
+            reference16.add(region.begin(), region.end());
+            etl::crc32_mpeg2 reference32;
+            reference32.add(region.begin(), region.end());
+            ASSERT_EQ(ComputeCrc16(region), static_cast<uint16_t>(reference16.value()))
+                << "CRC16 mismatch at length " << length << " alignment " << alignment;
+            ASSERT_EQ(ComputeCrc32(region), reference32.value())
+                << "CRC32 mismatch at length " << length << " alignment " << alignment;
+        }
+    }
+}
+
+TEST(SpIOpen_Algorithms, CrcIncrementalMatchesOneShot) {
+    static constexpr size_t kLength = 2048U + 13U;
+    static uint8_t data[kLength];
+    for (size_t i = 0U; i < kLength; ++i) {
+        data[i] = static_cast<uint8_t>((i * 131U) ^ (i >> 3U));
+    }
+    const uint16_t expected_crc16 = ComputeCrc16(etl::span<const uint8_t>(data, kLength));
+    const uint32_t expected_crc32 = ComputeCrc32(etl::span<const uint8_t>(data, kLength));
+
+    // chunk sizes straddle the slicing and folding block sizes, and include empty chunks
+    static constexpr size_t kChunkSizes[] = {0U, 1U, 2U, 3U, 7U, 8U, 15U, 16U, 17U, 63U, 64U, 65U, 1000U};
+    for (const size_t chunk_size : kChunkSizes) {
+        Crc16Context crc16 = Crc16Init();
+        Crc32Context crc32 = Crc32Init();
+        size_t offset = 0U;
+        size_t step = 0U;
+        while (offset < kLength) {
+            // alternate the requested chunk with a 1-byte chunk so the pieces do not stay block aligned
+            const size_t requested = ((step++ & 1U) != 0U) ? 1U : chunk_size;
+            const size_t length = (kLength - offset < requested) ? kLength - offset : requested;
+            Crc16Update(crc16, etl::span<const uint8_t>(data + offset, length));
+            Crc32Update(crc32, etl::span<const uint8_t>(data + offset, length));
+            offset += length;
+        }
+        EXPECT_EQ(Crc16Finalize(crc16), expected_crc16) << "CRC16 incremental mismatch for chunk size " << chunk_size;
+        EXPECT_EQ(Crc32Finalize(crc32), expected_crc32) << "CRC32 incremental mismatch for chunk size " << chunk_size;
+    }
+
+    Crc16Context empty16 = Crc16Init();
+    Crc16Update(empty16, etl::span<const uint8_t>());
+    EXPECT_EQ(Crc16Finalize(empty16), ComputeCrc16(etl::span<const uint8_t>())) << "CRC16 of no data";
+}
+
 TEST(SpIOpen_Algorithms, SecdedEncodingAccuracy) {
     static constexpr uint16_t kRaw = 0x0123U;  // 0b001'0010'0011
     // check with http://www.mathaddict.net/hamming.htm, but note that they put the parity bits at LSb and we put them
@@ -68,3 +130,23 @@ TEST(SpIOpen_Algorithms, SecdedDoubleBitDetect) {
         }
     }
 }
+
+TEST(SpIOpen_Algorithms, SecdedExhaustiveSingleAndDoubleBitErrors) {
+    static constexpr uint16_t bitmask_11 = 0x07FFU;
+    for (uint16_t raw11 = 0U; raw11 <= bitmask_11; ++raw11) {
+        const uint16_t encoded = spiopen::algorithms::Secded16Encode11(raw11);
+        ASSERT_EQ(__builtin_popcount(encoded) % 2, 0) << "SECDED overall parity for " << raw11;
+        for (uint8_t i = 0U; i < 16U; ++i) {
+            const Secded16DecodeResult single =
+                spiopen::algorithms::Secded16Decode11(static_cast<uint16_t>(encoded ^ (1U << i)));
+            ASSERT_TRUE(single.corrected && !single.uncorrectable && single.data11 == raw11)
+                << "SECDED single bit correction for " << raw11 << " bit #" << static_cast<int>(i);
+            for (uint8_t j = static_cast<uint8_t>(i + 1U); j < 16U; ++j) {
+                const Secded16DecodeResult dual =
+                    spiopen::algorithms::Secded16Decode11(static_cast<uint16_t>(encoded ^ (1U << i) ^ (1U << j)));
+                ASSERT_TRUE(dual.uncorrectable) << "SECDED double bit detect for " << raw11 << " bits #"
+                                                << static_cast<int>(i) << " and #" << static_cast<int>(j);
+            }
+        }
+    }
+}
@@ -4,16 +4,21 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <random>
+#include <vector>
 
 #include "spiopen_frame.h"
 #include "spiopen_frame_algorithms.h"
 #include "spiopen_frame_format.h"
 #include "spiopen_frame_reader.h"
+#include "spiopen_frame_test_helpers.h"
+#include "spiopen_frame_writer.h"
 
 using namespace spiopen;
 using namespace spiopen::format;
 using namespace spiopen::frame_reader;
 using namespace spiopen::frame_reader::impl;
+using namespace spiopen::test_helpers;
 
 static uint16_t EncodeFormatHeader11(uint8_t dlc_nibble, bool IDE, bool FDF, bool XLF, bool TTL, bool WA) {
     const uint16_t low = (dlc_nibble & HEADER_DLC_MASK) | (IDE ? HEADER_IDE_MASK : 0U) | (FDF ? HEADER_FDF_MASK : 0U) |
@@ -418,6 +423,33 @@ TEST(SpIOpen_FrameReader, CopyFromBitSlippedBuffer) {
         auto ret = CopyFromBitSlippedBuffer(src, dest, 2, 0);
         EXPECT_FALSE(ret) << "CopyFromBitSlippedBuffer should fail when source has fewer bytes than bytes_to_copy";
     }
+
+    {
+        // every length up to a few vector blocks at every slip: the realigned bytes match the original, nothing past
+        // the end is written, and the source is left on the extra byte for the next call
+        static constexpr size_t kMaxLength = 100U;
+        uint8_t original[kMaxLength];
+        for (size_t i = 0U; i < kMaxLength; ++i) {
+            original[i] = static_cast<uint8_t>((i * 73U) ^ 0x5CU);
+        }
+        for (uint8_t slip = 1U; slip < 8U; ++slip) {
+            uint8_t slipped[kMaxLength + 1U];
+            BitSlipBuffer(original, kMaxLength, slipped, slip);
+            for (size_t length = 0U; length < kMaxLength; ++length) {
+                uint8_t dest_buf[kMaxLength + 1U];
+                std::memset(dest_buf, 0xEE, sizeof(dest_buf));
+                etl::byte_stream_reader src(slipped, length + 1U, etl::endian::big);
+                etl::byte_stream_writer dest(etl::span<uint8_t>(dest_buf, sizeof(dest_buf)), etl::endian::big);
+                ASSERT_TRUE(CopyFromBitSlippedBuffer(src, dest, length, slip))
+                    << "length " << length << " slip " << static_cast<int>(slip);
+                EXPECT_EQ(0, std::memcmp(dest_buf, original, length))
+                    << "length " << length << " slip " << static_cast<int>(slip);
+                EXPECT_EQ(dest_buf[length], 0xEE) << "length " << length << " slip " << static_cast<int>(slip);
+                EXPECT_EQ(src.available_bytes(), 1U) << "length " << length << " slip " << static_cast<int>(slip);
+                EXPECT_EQ(dest.size_bytes(), length) << "length " << length << " slip " << static_cast<int>(slip);
+            }
+        }
+    }
 }
 
 TEST(SpIOpen_FrameReader, FindNextPreambleByte) {
@@ -459,6 +491,89 @@ TEST(SpIOpen_FrameReader, FindNextPreambleByte) {
     }
 }
 
+TEST(SpIOpen_FrameReader, ScanForPreamble) {
+    // preamble bytes and complements in noise, checked against a plain byte loop from every offset so that
+    // matches land in every lane of the vector blocks, in the scalar tail, and straddle block boundaries
+    uint8_t buffer[150];
+    uint32_t state = 0x12345678U;
+    for (size_t i = 0U; i < sizeof(buffer); ++i) {
+        state = state * 1103515245U + 12345U;
+        const uint8_t roll = static_cast<uint8_t>(state >> 24U);
+        buffer[i] = (roll < 48U) ? PREAMBLE_BYTE : (roll < 64U) ? PREAMBLE_BYTE_COMPLEMENT : (roll & 0x3FU);
+    }
+    for (size_t length = 0U; length <= sizeof(buffer); length += 7U) {
+        const etl::span<const uint8_t> span(buffer, length);
+        for (size_t offset = 0U; offset <= length; ++offset) {
+            size_t expected_byte = length;
+            size_t expected_complement = length;
+            size_t expected_word = length;
+            for (size_t i = length; i-- > offset;) {
+                if (buffer[i] == PREAMBLE_BYTE) {
+                    expected_byte = i;
+                    expected_complement = i;
+                    if (i + 1U < length && buffer[i + 1U] == PREAMBLE_BYTE) {
+                        expected_word = i;
+                    }
+                } else if (buffer[i] == PREAMBLE_BYTE_COMPLEMENT) {
+                    expected_complement = i;
+                }
+            }
+            EXPECT_EQ(ScanForPreambleByte(span, offset, false), expected_byte)
+                << "length " << length << " offset " << offset;
+            EXPECT_EQ(ScanForPreambleByte(span, offset, true), expected_complement)
+                << "length " << length << " offset " << offset;
+            EXPECT_EQ(ScanForPreambleWord(span, offset), expected_word) << "length " << length << " offset " << offset;
+        }
+    }
+}
+
+TEST(SpIOpen_FrameReader, FindNextFramePreambleMatchesCandidateWalk) {
+    // line noise patterns with a candidate every byte or two that is (mostly) rejected, checked against trying every
+    // candidate byte in turn
+    const uint8_t patterns[][4] = {
+        {0x00, PREAMBLE_BYTE_COMPLEMENT, 0x00, PREAMBLE_BYTE_COMPLEMENT},  // complements with the wrong bit before
+        {PREAMBLE_BYTE, 0x00, PREAMBLE_BYTE, 0x00},                        // lone preamble bytes
+        {PREAMBLE_BYTE, 0x01, PREAMBLE_BYTE_COMPLEMENT, 0x10},
+        {0x3C, PREAMBLE_BYTE_COMPLEMENT, 0xC3, PREAMBLE_BYTE},
+    };
+    uint8_t buffer[101];
+    for (const auto& pattern : patterns) {
+        for (size_t i = 0U; i < sizeof(buffer); ++i) {
+            buffer[i] = pattern[i % 4U];
+        }
+        buffer[sizeof(buffer) - 3U] = 0x00U;  // one real preamble at the very end
+        buffer[sizeof(buffer) - 2U] = PREAMBLE_BYTE;
+        buffer[sizeof(buffer) - 1U] = PREAMBLE_BYTE;
+        const etl::span<uint8_t> span(buffer, sizeof(buffer));
+        for (size_t offset = 0U; offset < sizeof(buffer); ++offset) {
+            FrameSearchResult expected{};
+            expected.valid_preamble_found = false;
+            for (size_t i = offset; i < sizeof(buffer) && !expected.valid_preamble_found; ++i) {
+                if (buffer[i] != PREAMBLE_BYTE && buffer[i] != PREAMBLE_BYTE_COMPLEMENT) {
+                    continue;
+                }
+                auto bits = CountBitOffsetIntoPreviousByte(span, i);
+                if (bits) {
+                    expected.valid_preamble_found = true;
+                    expected.bit_slip_count = (*bits > 0U) ? static_cast<int8_t>(8U - *bits) : 0;
+                    expected.frame_start_offset = *bits > 0U ? i - 1U : i;
+                }
+            }
+            const FrameSearchResult result = FindNextFramePreamble(span, offset);
+            ASSERT_EQ(result.valid_preamble_found, expected.valid_preamble_found) << "offset " << offset;
+            if (expected.valid_preamble_found) {
+                EXPECT_EQ(result.frame_start_offset, expected.frame_start_offset) << "offset " << offset;
+                EXPECT_EQ(result.bit_slip_count, expected.bit_slip_count) << "offset " << offset;
+            }
+            const FrameSearchResult aligned = FindNextFramePreamble(span, offset, false);
+            ASSERT_EQ(aligned.valid_preamble_found, offset <= sizeof(buffer) - 2U) << "offset " << offset;
+            if (aligned.valid_preamble_found) {
+                EXPECT_EQ(aligned.frame_start_offset, sizeof(buffer) - 2U) << "offset " << offset;
+            }
+        }
+    }
+}
+
 TEST(SpIOpen_FrameReader, CountBitOffsetIntoPreviousByte) {
     {
         // Aligned 2-byte preamble at start
@@ -498,6 +613,17 @@ TEST(SpIOpen_FrameReader, CountBitOffsetIntoPreviousByte) {
         }
     }
 
+    {
+        // Lone preamble byte: neither the byte before nor the byte after continue the pattern
+        uint8_t buffer[] = {0x00, PREAMBLE_BYTE, 0x00};
+        etl::span<uint8_t> buf_span(buffer, sizeof(buffer));
+        auto ret = CountBitOffsetIntoPreviousByte(buf_span, 1);
+        EXPECT_FALSE(ret) << "CountBitOffsetIntoPreviousByte should fail for a preamble byte without a second one";
+        if (!ret) {
+            EXPECT_EQ(ret.error(), FrameParseError::NoPreamble) << "error should be NoPreamble";
+        }
+    }
+
     {
         // First byte not matching second for 2-byte preamble at index 0
         uint8_t buffer[] = {PREAMBLE_BYTE, 0x00};
@@ -509,3 +635,562 @@ TEST(SpIOpen_FrameReader, CountBitOffsetIntoPreviousByte) {
         }
     }
 }
+
+TEST(SpIOpen_FrameReader, MatchPreambleSlips) {
+    // every 3-byte window around a candidate byte against shifting the 16-bit pattern across the window
+    const uint32_t pattern = (static_cast<uint32_t>(PREAMBLE_BYTE) << 8U) | PREAMBLE_BYTE;
+    for (const uint8_t candidate : {PREAMBLE_BYTE, PREAMBLE_BYTE_COMPLEMENT, static_cast<uint8_t>(0x00U)}) {
+        for (uint32_t previous = 0U; previous < 256U; ++previous) {
+            for (uint32_t next = 0U; next < 256U; ++next) {
+                const uint32_t window = (previous << 16U) | (static_cast<uint32_t>(candidate) << 8U) | next;
+                uint8_t expected = ((window & 0xFFFFU) == pattern) ? 0x01U : 0x00U;
+                uint8_t expected_without_previous = expected;
+                for (uint8_t slip = 1U; slip < 8U; ++slip) {
+                    if (((window >> (8U - slip)) & 0xFFFFU) == pattern) {
+                        expected |= static_cast<uint8_t>(1U << slip);
+                    }
+                }
+                const uint8_t previous_byte = static_cast<uint8_t>(previous);
+                const uint8_t next_byte = static_cast<uint8_t>(next);
+                ASSERT_EQ(MatchPreambleSlips(previous_byte, candidate, next_byte, true), expected)
+                    << "previous " << previous << " candidate " << static_cast<int>(candidate) << " next " << next;
+                ASSERT_EQ(MatchPreambleSlips(previous_byte, candidate, next_byte, false), expected_without_previous)
+                    << "no previous byte, candidate " << static_cast<int>(candidate) << " next " << next;
+            }
+        }
+    }
+}
+
+TEST(SpIOpen_FrameReader, PreambleDetector) {
+    // a frame bit slipped by every count behind some idle bytes: the streaming detector and the buffer search agree on
+    // where the frame starts and how far it slipped, and the frame reads back from there
+    uint8_t payload[12];
+    for (size_t i = 0U; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>(0x11U * i);
+    }
+    Frame frame{};
+    frame.can_flags.FDF = 1;
+    frame.can_identifier = 0x123U;
+    frame.payload = etl::span<uint8_t>(payload, sizeof(payload));
+    uint8_t encoded[64] = {0};
+    etl::byte_stream_writer writer(etl::span<uint8_t>(encoded, sizeof(encoded)), etl::endian::big);
+    ASSERT_TRUE(frame_writer::WriteFrame(writer, frame));
+    const size_t frame_size = writer.size_bytes();
+
+    for (uint8_t slip = 0U; slip < 8U; ++slip) {
+        static constexpr size_t kIdle = 5U;
+        uint8_t capture[kIdle + sizeof(encoded) + 1U] = {0};
+        BitSlipBuffer(encoded, frame_size, capture + kIdle, slip);
+        const etl::span<uint8_t> capture_span(capture, kIdle + frame_size + 1U);
+
+        const FrameSearchResult searched = FindNextFramePreamble(capture_span, 0U);
+        ASSERT_TRUE(searched.valid_preamble_found) << "buffer search, slip " << static_cast<int>(slip);
+        EXPECT_EQ(searched.frame_start_offset, kIdle) << "buffer search, slip " << static_cast<int>(slip);
+        EXPECT_EQ(searched.bit_slip_count, static_cast<int8_t>(slip))
+            << "buffer search, slip " << static_cast<int>(slip);
+
+        PreambleDetector detector;
+        FrameSearchResult detected{};
+        detected.valid_preamble_found = false;
+        for (size_t i = 0U; i < capture_span.size() && !detected.valid_preamble_found; ++i) {
+            detected = detector.Push(capture[i]);
+        }
+        ASSERT_TRUE(detected.valid_preamble_found) << "streaming detector, slip " << static_cast<int>(slip);
+        EXPECT_EQ(detected.frame_start_offset, searched.frame_start_offset)
+            << "streaming detector, slip " << static_cast<int>(slip);
+        EXPECT_EQ(detected.bit_slip_count, searched.bit_slip_count)
+            << "streaming detector, slip " << static_cast<int>(slip);
+        EXPECT_EQ(detector.GetBytesPushed(), kIdle + PREAMBLE_SIZE + ((slip == 0U) ? 0U : 1U))
+            << "detected as soon as the preamble is complete, slip " << static_cast<int>(slip);
+
+        etl::byte_stream_reader input(capture + detected.frame_start_offset,
+                                      capture_span.size() - detected.frame_start_offset, etl::endian::big);
+        uint8_t destination[64] = {0};
+        Frame read_frame{};
+        auto read = ReadAndCopyFrame(input, etl::span<uint8_t>(destination, sizeof(destination)), read_frame,
+                                     static_cast<uint8_t>(detected.bit_slip_count));
+        ASSERT_TRUE(read) << "frame reads back after detection, slip " << static_cast<int>(slip);
+        EXPECT_EQ(read_frame.can_identifier, frame.can_identifier);
+
+        detector.Reset();
+        EXPECT_EQ(detector.GetBytesPushed(), 0U) << "reset clears the stream offset";
+    }
+}
+
+TEST(SpIOpen_FrameReader, CopyFromBitSlippedBufferWithCrc) {
+    static constexpr size_t kLength = 300U;
+    uint8_t original[kLength];
+    for (size_t i = 0U; i < kLength; ++i) {
+        original[i] = static_cast<uint8_t>(i * 7U + 3U);
+    }
+    const etl::span<const uint8_t> original_span(original, kLength);
+
+    for (uint8_t slip = 0U; slip < 8U; ++slip) {
+        uint8_t slipped[kLength + 1U] = {0};
+        uint8_t dest_buf[kLength] = {0};
+        BitSlipBuffer(original, kLength, slipped, slip);
+        etl::byte_stream_reader src(slipped, sizeof(slipped), etl::endian::big);
+        etl::byte_stream_writer dest(etl::span<uint8_t>(dest_buf, sizeof(dest_buf)), etl::endian::big);
+        FrameCrc crc(MAX_FD_PAYLOAD_SIZE);  // long CRC
+        ASSERT_TRUE(CopyFromBitSlippedBuffer(src, dest, kLength, slip, crc))
+            << "fused copy should succeed for bit slip " << static_cast<int>(slip);
+        EXPECT_EQ(0, std::memcmp(dest_buf, original, kLength))
+            << "fused copy realigns bit slip " << static_cast<int>(slip);
+        EXPECT_EQ(crc.GetValue(), algorithms::ComputeCrc32(original_span))
+            << "fused copy CRC matches one-shot CRC for bit slip " << static_cast<int>(slip);
+    }
+
+    {
+        // dest too small: nothing is copied and the CRC is untouched
+        uint8_t dest_buf[4] = {0};
+        etl::byte_stream_reader src(original, kLength, etl::endian::big);
+        etl::byte_stream_writer dest(etl::span<uint8_t>(dest_buf, sizeof(dest_buf)), etl::endian::big);
+        FrameCrc crc(0U);
+        EXPECT_FALSE(CopyFromBitSlippedBuffer(src, dest, 5U, 0U, crc)) << "fused copy fails when dest is too small";
+        EXPECT_EQ(dest.size_bytes(), 0U) << "fused copy writes nothing when it fails up front";
+        EXPECT_EQ(crc.GetValue(), static_cast<uint32_t>(algorithms::CRC16_INITIAL_VALUE)) << "CRC untouched on failure";
+    }
+}
+
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+TEST(SpIOpen_FrameReader, ReadAndCopyFrameBitSlippedXl) {
+    static constexpr size_t kPayloadSize = MAX_XL_PAYLOAD_SIZE - 1U;  // largest length the 11-bit XL field encodes
+    static uint8_t payload[kPayloadSize];
+    for (size_t i = 0U; i < kPayloadSize; ++i) {
+        payload[i] = static_cast<uint8_t>(i ^ (i >> 8U));
+    }
+    Frame frame_to_write{};
+    frame_to_write.can_flags.XLF = 1;
+    frame_to_write.can_flags.FDF = 1;
+    frame_to_write.can_flags.TTL = 1;
+    frame_to_write.can_flags.WA = 1;
+    frame_to_write.time_to_live = 9U;
+    frame_to_write.can_identifier = 0x5A5U;
+    frame_to_write.xl_control.addressing_field = 0x01020304U;
+    frame_to_write.payload = etl::span<uint8_t>(payload, kPayloadSize);
+
+    static uint8_t wire[MAX_CAN_XL_FRAME_SIZE];
+    etl::byte_stream_writer writer(etl::span<uint8_t>(wire, sizeof(wire)), etl::endian::big);
+    ASSERT_TRUE(frame_writer::WriteFrame(writer, frame_to_write)) << "WriteFrame must succeed for XL frame";
+    const size_t frame_length = writer.size_bytes();
+
+    static uint8_t slipped[MAX_CAN_XL_FRAME_SIZE + 1U];
+    static uint8_t destination[MAX_CAN_XL_FRAME_SIZE];
+    for (uint8_t slip = 0U; slip < 8U; ++slip) {
+        BitSlipBuffer(wire, frame_length, slipped, slip);
+        etl::byte_stream_reader input(slipped, frame_length + 1U, etl::endian::big);
+        Frame frame{};
+        auto ret = ReadAndCopyFrame(input, etl::span<uint8_t>(destination, sizeof(destination)), frame, slip);
+        ASSERT_TRUE(ret) << "ReadAndCopyFrame should succeed for XL frame with bit slip " << static_cast<int>(slip)
+                         << " (error " << static_cast<int>(ret.error()) << ")";
+        EXPECT_EQ(frame.can_identifier, 0x5A5U) << "CAN ID after slip " << static_cast<int>(slip);
+        EXPECT_EQ(frame.time_to_live, 9U) << "TTL after slip " << static_cast<int>(slip);
+        ASSERT_EQ(frame.payload.size(), kPayloadSize) << "payload size after slip " << static_cast<int>(slip);
+        EXPECT_EQ(0, std::memcmp(frame.payload.data(), payload, kPayloadSize))
+            << "payload after slip " << static_cast<int>(slip);
+    }
+
+    // a flipped payload bit must still be caught by the CRC accumulated during the copy
+    wire[PREAMBLE_SIZE + frame_to_write.GetHeaderLength() + 1000U] ^= 0x10U;
+    BitSlipBuffer(wire, frame_length, slipped, 3U);
+    etl::byte_stream_reader input(slipped, frame_length + 1U, etl::endian::big);
+    Frame frame{};
+    auto ret = ReadAndCopyFrame(input, etl::span<uint8_t>(destination, sizeof(destination)), frame, 3U);
+    EXPECT_FALSE(ret) << "ReadAndCopyFrame should detect a corrupted payload";
+    if (!ret) {
+        EXPECT_EQ(ret.error(), FrameParseError::CrcMismatch) << "error should be CrcMismatch";
+    }
+}
+#endif
+
+TEST(SpIOpen_FrameReader, ReadFrameWordAligned) {
+    uint8_t payload[12] = {1U, 2U, 3U, 4U, 5U, 6U, 7U, 8U, 9U, 10U, 11U, 12U};
+    // payload sizes and TTL chosen so that both odd (padded) and even (unpadded) frames are covered
+    for (size_t payload_size : {0U, 1U, 2U, 8U, 12U}) {
+        for (uint8_t ttl = 0U; ttl < 2U; ++ttl) {
+            Frame frame{};
+            frame.can_identifier = 0x2AU;
+            frame.can_flags.WA = 1;
+            frame.can_flags.TTL = ttl;
+            frame.can_flags.FDF = (payload_size > MAX_CC_PAYLOAD_SIZE) ? 1 : 0;
+            frame.time_to_live = 3U;
+            frame.payload = etl::span<uint8_t>(payload, payload_size);
+            uint8_t buffer[MAX_CAN_FD_FRAME_SIZE] = {0};
+            etl::byte_stream_writer writer(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+            ASSERT_TRUE(frame_writer::WriteFrame(writer, frame));
+            ASSERT_TRUE(etl::is_even(writer.size_bytes()));
+
+            etl::byte_stream_reader reader(buffer, writer.size_bytes(), etl::endian::big);
+            Frame read_frame{};
+            auto ret = ReadFrame(reader, read_frame);
+            ASSERT_TRUE(ret) << "ReadFrame should succeed for word aligned frame with payload size " << payload_size
+                             << " and TTL " << static_cast<int>(ttl) << " (error "
+                             << (ret ? 0 : static_cast<int>(ret.error())) << ")";
+            EXPECT_EQ(reader.used_data().size(), writer.size_bytes()) << "ReadFrame should consume the padding";
+            EXPECT_EQ(read_frame.payload.size(), payload_size);
+        }
+    }
+}
+
+TEST(SpIOpen_FrameReader, ReadFrameWideAligned) {
+    uint8_t payload[MAX_FD_PAYLOAD_SIZE];
+    for (size_t i = 0U; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>(i + 1U);
+    }
+#ifdef CONFIG_SPIOPEN_FRAME_WIDE_ALIGNMENT_ENABLE
+    // DWA alone pads to a multiple of four bytes, DWA with WA to a multiple of eight
+    for (uint8_t wa = 0U; wa < 2U; ++wa) {
+        const size_t alignment = wa ? 8U : 4U;
+        for (size_t payload_size : {0U, 1U, 2U, 3U, 5U, 8U, 12U, 20U}) {
+            for (uint8_t ttl = 0U; ttl < 2U; ++ttl) {
+                Frame frame{};
+                frame.can_identifier = 0x2AU;
+                frame.can_flags.WA = wa;
+                frame.can_flags.DWA = 1;
+                frame.can_flags.TTL = ttl;
+                frame.can_flags.FDF = (payload_size > MAX_CC_PAYLOAD_SIZE) ? 1 : 0;
+                frame.time_to_live = 3U;
+                frame.payload = etl::span<uint8_t>(payload, payload_size);
+                ASSERT_EQ(frame.GetAlignment(), alignment);
+                uint8_t buffer[MAX_CAN_FD_FRAME_SIZE + 1U] = {0};
+                etl::byte_stream_writer writer(etl::span<uint8_t>(buffer, MAX_CAN_FD_FRAME_SIZE), etl::endian::big);
+                ASSERT_TRUE(frame_writer::WriteFrame(writer, frame));
+                const size_t frame_length = writer.size_bytes();
+                EXPECT_EQ(frame_length % alignment, 0U);
+                size_t expected_length = 0U;
+                ASSERT_TRUE(frame.TryGetFrameLength(expected_length));
+                EXPECT_EQ(frame_length, expected_length);
+                auto peeked = PeekFrameLength(etl::span<const uint8_t>(buffer, frame_length));
+                ASSERT_TRUE(peeked);
+                EXPECT_EQ(*peeked, frame_length);
+
+                etl::byte_stream_reader reader(buffer, frame_length, etl::endian::big);
+                Frame read_frame{};
+                auto ret = ReadFrame(reader, read_frame);
+                ASSERT_TRUE(ret) << "payload size " << payload_size << " alignment " << alignment;
+                EXPECT_EQ(reader.used_data().size(), frame_length) << "ReadFrame should consume the padding";
+                ASSERT_GE(read_frame.payload.size(), payload_size) << "FD payloads are padded up to a DLC size";
+                EXPECT_EQ(std::memcmp(read_frame.payload.data(), payload, payload_size), 0);
+                EXPECT_EQ(read_frame.can_flags.DWA, 1U);
+                EXPECT_EQ(read_frame.can_flags.WA, wa);
+
+                // the same frame slipped by three bits
+                uint8_t slipped[MAX_CAN_FD_FRAME_SIZE + 1U] = {0};
+                BitSlipBuffer(buffer, frame_length, slipped, 3U);
+                etl::byte_stream_reader slipped_reader(slipped, frame_length + 1U, etl::endian::big);
+                uint8_t destination[MAX_CAN_FD_FRAME_SIZE];
+                ASSERT_TRUE(ReadAndCopyFrame(slipped_reader, etl::span<uint8_t>(destination, sizeof(destination)),
+                                             read_frame, 3U));
+                EXPECT_EQ(std::memcmp(destination, buffer, frame_length), 0);
+            }
+        }
+    }
+#else
+    // without wide alignment, the DWA flag is refused on both sides
+    Frame frame{};
+    frame.can_flags.DWA = 1;
+    frame.payload = etl::span<uint8_t>(payload, 3U);
+    uint8_t buffer[MAX_CAN_CC_FRAME_SIZE + 8U] = {0};
+    etl::byte_stream_writer writer(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+    auto written = frame_writer::WriteFrame(writer, frame);
+    ASSERT_FALSE(written);
+    EXPECT_EQ(written.error(), frame_writer::FrameWriteError::WideAlignmentNotSupported);
+
+    const uint16_t header = algorithms::Secded16Encode11(static_cast<uint16_t>(3U | (HEADER_DWA_MASK << 8U)));
+    Frame read_frame{};
+    bool dlc_corrected = false;
+    size_t payload_len = 0U;
+    auto ret = ParseFormatHeader(static_cast<uint8_t>(header >> 8U), static_cast<uint8_t>(header), read_frame,
+                                 dlc_corrected, payload_len);
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(ret.error(), FrameParseError::WideAlignmentNotSupported);
+#endif
+}
+
+TEST(SpIOpen_FrameReader, ParseAll) {
+    uint8_t capture[256] = {0};
+    size_t capture_length = 0U;
+    // write a CC frame into the capture after idle_bytes of 0x00, bit slipped; returns the offset of the frame
+    auto append_frame = [&](uint32_t can_identifier, size_t payload_size, uint8_t bit_slip_count, size_t idle_bytes) {
+        uint8_t payload[MAX_CC_PAYLOAD_SIZE] = {0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x66U, 0x77U, 0x88U};
+        Frame frame{};
+        frame.can_identifier = can_identifier;
+        frame.payload = etl::span<uint8_t>(payload, payload_size);
+        uint8_t encoded[MAX_CAN_CC_FRAME_SIZE] = {0};
+        etl::byte_stream_writer writer(etl::span<uint8_t>(encoded, sizeof(encoded)), etl::endian::big);
+        EXPECT_TRUE(frame_writer::WriteFrame(writer, frame));
+        capture_length += idle_bytes;
+        const size_t offset = capture_length;
+        BitSlipBuffer(encoded, writer.size_bytes(), capture + offset, bit_slip_count);
+        capture_length += writer.size_bytes() + ((bit_slip_count == 0U) ? 0U : 1U);
+        return offset;
+    };
+
+    const size_t frame_a = append_frame(0x12U, 3U, 0U, 2U);
+    capture[frame_a - 1U] = 0x02U;  // idle noise ending in preamble bits: the frame also matches at slip 6
+    // a false preamble: the header has two bit errors, which SECDED detects but cannot correct
+    const size_t false_preamble = capture_length + 3U;
+    const uint16_t corrupted_header = EncodeFormatHeader11(2, false, false, false, false, false) ^ 0x0006U;
+    capture[false_preamble] = PREAMBLE_BYTE;
+    capture[false_preamble + 1U] = PREAMBLE_BYTE;
+    capture[false_preamble + 2U] = static_cast<uint8_t>(corrupted_header >> 8U);
+    capture[false_preamble + 3U] = static_cast<uint8_t>(corrupted_header);
+    capture_length = false_preamble + 12U;
+    const size_t frame_b = append_frame(0x345U, 8U, 3U, 0U);
+    const size_t frame_c = append_frame(0x56U, 1U, 0U, 2U);
+    capture[capture_length - 1U] ^= 0x01U;  // corrupt the CRC of frame C
+    const size_t frame_d = append_frame(0x78U, 0U, 5U, 2U);
+    const size_t frame_e = append_frame(0x9AU, 4U, 1U, 2U);
+    capture_length = frame_e + 6U;  // frame E is cut off by the end of the capture
+    ASSERT_LE(capture_length, sizeof(capture));
+
+    const etl::span<uint8_t> buffer(capture, capture_length);
+    uint8_t scratch[MAX_CAN_CC_FRAME_SIZE] = {0};
+    FrameDescriptor descriptors[8] = {};
+    ParseAllResult result = ParseAll(buffer, etl::span<FrameDescriptor>(descriptors, 8U), etl::span<uint8_t>(scratch));
+    ASSERT_EQ(result.descriptor_count, 5U);
+    EXPECT_EQ(result.resume_offset, frame_e) << "the cut off frame is left for the next call";
+
+    const size_t expected_offsets[5] = {frame_a, false_preamble, frame_b, frame_c, frame_d};
+    const bool expected_valid[5] = {true, false, true, false, true};
+    const uint8_t expected_slips[5] = {0U, 0U, 3U, 0U, 5U};
+    const uint32_t expected_ids[5] = {0x12U, 0U, 0x345U, 0x56U, 0x78U};
+    const size_t expected_lengths[5] = {PREAMBLE_SIZE + FORMAT_HEADER_SIZE + CAN_IDENTIFIER_SIZE + 3U + 2U, 0U,
+                                        PREAMBLE_SIZE + FORMAT_HEADER_SIZE + CAN_IDENTIFIER_SIZE + 8U + 2U,
+                                        PREAMBLE_SIZE + FORMAT_HEADER_SIZE + CAN_IDENTIFIER_SIZE + 1U + 2U,
+                                        PREAMBLE_SIZE + FORMAT_HEADER_SIZE + CAN_IDENTIFIER_SIZE + 0U + 2U};
+    for (size_t i = 0U; i < 5U; ++i) {
+        EXPECT_EQ(descriptors[i].offset, expected_offsets[i]) << "descriptor " << i;
+        EXPECT_EQ(descriptors[i].valid, expected_valid[i]) << "descriptor " << i;
+        EXPECT_EQ(descriptors[i].bit_slip_count, expected_slips[i]) << "descriptor " << i;
+        EXPECT_EQ(descriptors[i].can_identifier, expected_ids[i]) << "descriptor " << i;
+        EXPECT_EQ(descriptors[i].length, expected_lengths[i]) << "descriptor " << i;
+        EXPECT_FALSE(descriptors[i].dlc_corrected) << "descriptor " << i;
+    }
+    EXPECT_EQ(descriptors[1].error, FrameParseError::FormatDlcCorrupted);
+    EXPECT_EQ(descriptors[3].error, FrameParseError::CrcMismatch);
+
+    // with room for only two descriptors, the next call starts at the third frame
+    result = ParseAll(buffer, etl::span<FrameDescriptor>(descriptors, 2U), etl::span<uint8_t>(scratch));
+    EXPECT_EQ(result.descriptor_count, 2U);
+    EXPECT_EQ(result.resume_offset, frame_b);
+
+    // idle data leaves the last two bytes for the next call, which may complete a preamble with it
+    const etl::span<uint8_t> idle(capture, frame_a);
+    result = ParseAll(idle, etl::span<FrameDescriptor>(descriptors, 8U), etl::span<uint8_t>(scratch));
+    EXPECT_EQ(result.descriptor_count, 0U);
+    EXPECT_EQ(result.resume_offset, 0U);
+
+    // at the end of the data the cut off frame is reported as failed and the whole capture is consumed
+    result = ParseAll(buffer, etl::span<FrameDescriptor>(descriptors, 8U), etl::span<uint8_t>(scratch), true, true);
+    ASSERT_EQ(result.descriptor_count, 6U);
+    EXPECT_EQ(result.resume_offset, capture_length);
+    EXPECT_EQ(descriptors[5].offset, frame_e);
+    EXPECT_FALSE(descriptors[5].valid);
+    EXPECT_EQ(descriptors[5].error, FrameParseError::BufferTooShortForHeader);
+}
+
+TEST(SpIOpen_FrameReader, ParseAllRandomIdleBytes) {
+    uint8_t scratch[MAX_CAN_CC_FRAME_SIZE] = {0};
+    FrameDescriptor descriptors[16] = {};
+    // encode a CC frame with payload_size bytes onto the end of stream
+    auto append_frame = [](std::vector<uint8_t>& stream, uint32_t can_identifier, size_t payload_size) {
+        uint8_t payload[MAX_CC_PAYLOAD_SIZE] = {0x11U, 0x22U, 0x33U, 0x44U, 0x55U, 0x66U, 0x77U, 0x88U};
+        Frame frame{};
+        frame.can_identifier = can_identifier;
+        frame.payload = etl::span<uint8_t>(payload, payload_size);
+        EXPECT_TRUE(AppendEncodedFrame(frame, stream));
+    };
+    auto valid_identifiers = [&](const ParseAllResult& result) {
+        std::vector<uint32_t> found;
+        for (size_t i = 0U; i < result.descriptor_count; ++i) {
+            if (descriptors[i].valid) {
+                found.push_back(descriptors[i].can_identifier);
+            }
+        }
+        return found;
+    };
+
+    {
+        // idle bytes that form a preamble and a header for an extended CAN ID, a TTL and 8 payload bytes, followed by a
+        // shorter frame: the false frame runs past the end of the capture
+        const uint16_t false_header = EncodeFormatHeader11(8, true, false, false, true, false);
+        std::vector<uint8_t> capture = {PREAMBLE_BYTE, PREAMBLE_BYTE, static_cast<uint8_t>(false_header >> 8U),
+                                        static_cast<uint8_t>(false_header)};
+        append_frame(capture, 0x123U, 4U);
+        const etl::span<uint8_t> buffer(capture.data(), capture.size());
+        // with more data to come, the false frame is left for the next call, and the frame after it with it
+        ParseAllResult result = ParseAll(buffer, etl::span<FrameDescriptor>(descriptors, 16U),
+                                         etl::span<uint8_t>(scratch));
+        EXPECT_EQ(result.descriptor_count, 0U);
+        EXPECT_EQ(result.resume_offset, 0U);
+        // at the end of the data the false frame is reported as failed and the search goes on
+        result =
+            ParseAll(buffer, etl::span<FrameDescriptor>(descriptors, 16U), etl::span<uint8_t>(scratch), true, true);
+        ASSERT_EQ(result.descriptor_count, 2U);
+        EXPECT_FALSE(descriptors[0].valid);
+        EXPECT_EQ(descriptors[0].error, FrameParseError::BufferTooShortForPayload);
+        EXPECT_EQ(valid_identifiers(result), std::vector<uint32_t>{0x123U});
+        EXPECT_EQ(result.resume_offset, capture.size());
+    }
+
+    // captures of a few frames with up to three random idle bytes around each, at a random bit slip
+    std::mt19937 random(1234U);
+    for (size_t run = 0U; run < 1000U; ++run) {
+        std::vector<uint8_t> stream;
+        std::vector<uint32_t> can_identifiers(4U);
+        for (size_t i = 0U; i <= can_identifiers.size(); ++i) {
+            for (size_t idle_bytes = random() % 4U; idle_bytes > 0U; --idle_bytes) {
+                stream.push_back(static_cast<uint8_t>(random()));
+            }
+            if (i < can_identifiers.size()) {
+                can_identifiers[i] = random() & 0x7FFU;
+                append_frame(stream, can_identifiers[i], random() % (MAX_CC_PAYLOAD_SIZE + 1U));
+            }
+        }
+        const uint8_t bit_slip_count = static_cast<uint8_t>(random() % 8U);
+        std::vector<uint8_t> capture = BitSlip(stream, bit_slip_count);
+        const ParseAllResult result =
+            ParseAll(etl::span<uint8_t>(capture.data(), capture.size()), etl::span<FrameDescriptor>(descriptors, 16U),
+                     etl::span<uint8_t>(scratch), true, true);
+        EXPECT_EQ(valid_identifiers(result), can_identifiers)
+            << "run " << run << ", slip " << static_cast<int>(bit_slip_count);
+        EXPECT_EQ(result.resume_offset, capture.size()) << "run " << run;
+    }
+}
+
+TEST(SpIOpen_FrameReader, PeekFrameLength) {
+    static uint8_t payload[MAX_XL_PAYLOAD_SIZE] = {0};
+    const size_t payload_sizes[] = {0U, 5U, 8U,
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
+                                    9U, 64U,
+#endif
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+                                    65U, 1001U, MAX_XL_PAYLOAD_SIZE - 1U,
+#endif
+    };
+    for (const size_t payload_size : payload_sizes) {
+        for (uint8_t flags = 0U; flags < 8U; ++flags) {
+            Frame frame{};
+            frame.can_flags.IDE = flags & 0x1U;
+            frame.can_flags.TTL = (flags >> 1U) & 0x1U;
+            frame.can_flags.WA = (flags >> 2U) & 0x1U;
+            frame.can_flags.FDF = (payload_size > MAX_CC_PAYLOAD_SIZE) ? 1 : 0;
+            frame.can_flags.XLF = (payload_size > MAX_FD_PAYLOAD_SIZE) ? 1 : 0;
+            frame.can_identifier = 0x1FU;
+            frame.payload = etl::span<uint8_t>(payload, payload_size);
+            static uint8_t encoded[MAX_CAN_XL_FRAME_SIZE];
+            etl::byte_stream_writer writer(etl::span<uint8_t>(encoded, sizeof(encoded)), etl::endian::big);
+            ASSERT_TRUE(frame_writer::WriteFrame(writer, frame));
+            const size_t needed = frame.can_flags.XLF ? LENGTH_PREFIX_SIZE : PREAMBLE_SIZE + FORMAT_HEADER_SIZE;
+
+            for (uint8_t slip = 0U; slip < 8U; ++slip) {
+                uint8_t slipped[LENGTH_PREFIX_SIZE + 1U] = {0};
+                BitSlipBuffer(encoded, LENGTH_PREFIX_SIZE, slipped, slip);
+                const size_t prefix_size = needed + ((slip == 0U) ? 0U : 1U);
+                auto ret = PeekFrameLength(etl::span<const uint8_t>(slipped, prefix_size), slip);
+                ASSERT_TRUE(ret) << "payload " << payload_size << " flags " << static_cast<int>(flags) << " slip "
+                                 << static_cast<int>(slip);
+                EXPECT_EQ(*ret, writer.size_bytes()) << "payload " << payload_size << " flags "
+                                                     << static_cast<int>(flags) << " slip " << static_cast<int>(slip);
+                ret = PeekFrameLength(etl::span<const uint8_t>(slipped, prefix_size - 1U), slip);
+                ASSERT_FALSE(ret);
+                EXPECT_EQ(ret.error(), FrameParseError::BufferTooShortToDetermineLength);
+            }
+        }
+    }
+
+    uint8_t prefix[LENGTH_PREFIX_SIZE] = {PREAMBLE_BYTE, PREAMBLE_BYTE, 0U, 0U, 0U, 0U};
+    const uint16_t header = EncodeFormatHeader11(3, true, false, false, true, false);  // CC, 3 bytes, IDE and TTL
+    const size_t expected_length = PREAMBLE_SIZE + FORMAT_HEADER_SIZE + CAN_IDENTIFIER_SIZE +
+                                   CAN_IDENTIFIER_EXTENSION_SIZE + TIME_TO_LIVE_SIZE + 3U + SHORT_CRC_SIZE;
+    for (size_t bit = 0U; bit < 16U; ++bit) {
+        const uint16_t corrupted = static_cast<uint16_t>(header ^ (1U << bit));
+        prefix[2] = static_cast<uint8_t>(corrupted >> 8U);
+        prefix[3] = static_cast<uint8_t>(corrupted);
+        auto ret = PeekFrameLength(etl::span<const uint8_t>(prefix, sizeof(prefix)));
+        ASSERT_TRUE(ret) << "a single bit error is corrected (bit " << bit << ")";
+        EXPECT_EQ(*ret, expected_length);
+
+        const uint16_t double_error = static_cast<uint16_t>(corrupted ^ (1U << ((bit + 5U) % 16U)));
+        prefix[2] = static_cast<uint8_t>(double_error >> 8U);
+        prefix[3] = static_cast<uint8_t>(double_error);
+        ret = PeekFrameLength(etl::span<const uint8_t>(prefix, sizeof(prefix)));
+        ASSERT_FALSE(ret);
+        EXPECT_EQ(ret.error(), FrameParseError::FormatDlcCorrupted);
+    }
+    prefix[0] = PREAMBLE_BYTE_COMPLEMENT;
+    EXPECT_EQ(PeekFrameLength(etl::span<const uint8_t>(prefix, sizeof(prefix))).error(), FrameParseError::NoPreamble);
+    EXPECT_EQ(PeekFrameLength(etl::span<const uint8_t>(prefix, sizeof(prefix)), 8U).error(),
+              FrameParseError::InvalidBitSlipCount);
+}
+
+TEST(SpIOpen_FrameReader, WrappedBuffer) {
+    // three frames with idle gaps, received into a ring buffer with the read index at every position
+    uint8_t payloads[3][20] = {};
+    const size_t payload_sizes[3] = {3U, 8U, 0U};
+    const uint32_t identifiers[3] = {0x12U, 0x1ABCDEFU, 0x7FFU};
+    uint8_t stream[96] = {0};
+    size_t stream_length = 0U;
+    for (size_t f = 0U; f < 3U; ++f) {
+        for (size_t i = 0U; i < sizeof(payloads[f]); ++i) {
+            payloads[f][i] = static_cast<uint8_t>(0x30U * f + i);
+        }
+        Frame frame{};
+        frame.can_identifier = identifiers[f];
+        frame.can_flags.IDE = (identifiers[f] > 0x7FFU) ? 1 : 0;
+        frame.can_flags.TTL = static_cast<unsigned int>(f & 1U);
+        frame.time_to_live = 4U;
+        frame.payload = etl::span<uint8_t>(payloads[f], payload_sizes[f]);
+        stream_length += 3U;
+        etl::byte_stream_writer writer(etl::span<uint8_t>(stream + stream_length, sizeof(stream) - stream_length),
+                                       etl::endian::big);
+        ASSERT_TRUE(frame_writer::WriteFrame(writer, frame));
+        stream_length += writer.size_bytes();
+    }
+    stream_length += 2U;
+
+    uint8_t destination[MAX_CAN_CC_FRAME_SIZE] = {0};
+    for (uint8_t slip = 0U; slip < 8U; ++slip) {
+        uint8_t slipped[sizeof(stream) + 1U] = {0};
+        BitSlipBuffer(stream, stream_length, slipped, slip);
+        const size_t received = stream_length + 1U;
+        for (size_t tail = 0U; tail < sizeof(slipped); ++tail) {
+            uint8_t ring[sizeof(slipped)] = {0};
+            for (size_t i = 0U; i < received; ++i) {
+                ring[(tail + i) % sizeof(ring)] = slipped[i];
+            }
+            const WrappedBuffer input =
+                WrappedBuffer::FromRing(etl::span<uint8_t>(ring, sizeof(ring)), tail, (tail + received) % sizeof(ring));
+            ASSERT_EQ(input.size(), received);
+
+            size_t offset = 0U;
+            for (size_t f = 0U; f < 3U; ++f) {
+                const FrameSearchResult found = FindNextFramePreamble(input, offset);
+                ASSERT_TRUE(found.valid_preamble_found) << "frame " << f << " slip " << static_cast<int>(slip)
+                                                        << " tail " << tail;
+                ASSERT_EQ(found.bit_slip_count, slip) << "frame " << f << " tail " << tail;
+                if (slip == 0U) {
+                    const FrameSearchResult aligned = FindNextFramePreamble(input, offset, false);
+                    ASSERT_TRUE(aligned.valid_preamble_found) << "frame " << f << " tail " << tail;
+                    EXPECT_EQ(aligned.frame_start_offset, found.frame_start_offset);
+                }
+                Frame frame{};
+                auto ret = ReadAndCopyFrame(input, found.frame_start_offset,
+                                            etl::span<uint8_t>(destination, sizeof(destination)), frame, slip);
+                ASSERT_TRUE(ret) << "frame " << f << " slip " << static_cast<int>(slip) << " tail " << tail
+                                 << " error " << static_cast<int>(ret.error());
+                EXPECT_EQ(frame.can_identifier, identifiers[f]);
+                ASSERT_EQ(frame.payload.size(), payload_sizes[f]);
+                EXPECT_EQ(0, std::memcmp(frame.payload.data(), payloads[f], payload_sizes[f]));
+                size_t frame_length = 0U;
+                ASSERT_TRUE(frame.TryGetFrameLength(frame_length));
+                offset = found.frame_start_offset + frame_length;
+            }
+            EXPECT_FALSE(FindNextFramePreamble(input, offset).valid_preamble_found);
+            if (slip == 0U) {
+                EXPECT_FALSE(FindNextFramePreamble(input, offset, false).valid_preamble_found);
+            }
+        }
+    }
+}
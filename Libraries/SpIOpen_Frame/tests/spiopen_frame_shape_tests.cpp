@@ -0,0 +1,161 @@
+#include <etl/byte_stream.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "spiopen_frame.h"
+#include "spiopen_frame_algorithms.h"
+#include "spiopen_frame_format.h"
+#include "spiopen_frame_reader.h"
+#include "spiopen_frame_shape.h"
+#include "spiopen_frame_writer.h"
+
+using namespace spiopen;
+using namespace spiopen::format;
+
+namespace {
+
+Frame MakeFrame(const size_t payload_size, const bool extended, const bool time_to_live, const bool word_aligned,
+                const bool fd, uint8_t* payload) {
+    Frame frame{};
+    frame.can_flags.IDE = extended;
+    frame.can_flags.TTL = time_to_live;
+    frame.can_flags.WA = word_aligned;
+    frame.can_flags.FDF = fd;
+    frame.can_flags.BRS = fd;
+    frame.can_identifier = extended ? 0x0BADCAFEU : 0x3C5U;
+    frame.time_to_live = 42U;
+    for (size_t i = 0U; i < payload_size; ++i) {
+        payload[i] = static_cast<uint8_t>((i * 29U) + 7U);
+    }
+    frame.payload = etl::span<uint8_t>(payload, payload_size);
+    return frame;
+}
+
+// Write a frame of the shape with WriteShapedFrame() and WriteFrame(), check they agree, then read it back with
+// ReadShapedFrame() and ReadFrame()
+template <typename Shape>
+void ExpectShapeMatchesGenericPath() {
+    uint8_t payload[MAX_FD_PAYLOAD_SIZE];
+    const Frame frame = MakeFrame(Shape::PAYLOAD_SIZE, Shape::IDE, Shape::TTL, Shape::WA, Shape::FDF, payload);
+    ASSERT_TRUE(Shape::Matches(frame));
+
+    uint8_t expected[MAX_CAN_FD_FRAME_SIZE];
+    etl::byte_stream_writer expected_stream(etl::span<uint8_t>(expected, sizeof(expected)), etl::endian::big);
+    ASSERT_TRUE(frame_writer::WriteFrame(expected_stream, frame));
+    ASSERT_EQ(expected_stream.size_bytes(), Shape::FRAME_LENGTH);
+
+    uint8_t buffer[MAX_CAN_FD_FRAME_SIZE];
+    std::memset(buffer, 0xEE, sizeof(buffer));
+    etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+    ASSERT_TRUE(frame_writer::WriteShapedFrame<Shape>(stream, frame));
+    ASSERT_EQ(stream.size_bytes(), Shape::FRAME_LENGTH);
+    EXPECT_EQ(std::memcmp(buffer, expected, Shape::FRAME_LENGTH), 0);
+    EXPECT_EQ(buffer[Shape::FRAME_LENGTH], 0xEEU);
+
+    etl::byte_stream_reader reader(buffer, Shape::FRAME_LENGTH, etl::endian::big);
+    Frame read{};
+    ASSERT_TRUE(frame_reader::ReadShapedFrame<Shape>(reader, read));
+    EXPECT_EQ(reader.available_bytes(), 0U);
+    EXPECT_EQ(read.can_identifier, frame.can_identifier);
+    EXPECT_EQ(read.can_flags.IDE, frame.can_flags.IDE);
+    EXPECT_EQ(read.can_flags.FDF, frame.can_flags.FDF);
+    EXPECT_EQ(read.can_flags.BRS, frame.can_flags.BRS);
+    EXPECT_EQ(read.can_flags.TTL, frame.can_flags.TTL);
+    EXPECT_EQ(read.can_flags.WA, frame.can_flags.WA);
+    EXPECT_EQ(read.time_to_live, Shape::TTL ? frame.time_to_live : 0U);
+    ASSERT_EQ(read.payload.size(), Shape::PAYLOAD_SIZE);
+    EXPECT_EQ(std::memcmp(read.payload.data(), payload, Shape::PAYLOAD_SIZE), 0);
+}
+
+}  // namespace
+
+TEST(SpIOpen_FrameShape, FormatHeaderEncoding) {
+    for (uint16_t raw11 = 0U; raw11 < 0x0800U; ++raw11) {
+        ASSERT_EQ(format::Secded16Encode11Bitwise(raw11), algorithms::Secded16Encode11(raw11)) << raw11;
+    }
+}
+
+TEST(SpIOpen_FrameShape, MatchesGenericPath) {
+    ExpectShapeMatchesGenericPath<FrameShape<0U>>();
+    ExpectShapeMatchesGenericPath<FrameShape<8U>>();
+    ExpectShapeMatchesGenericPath<FrameShape<5U, true, true, true>>();
+    ExpectShapeMatchesGenericPath<FrameShape<8U, false, false, true>>();
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
+    ExpectShapeMatchesGenericPath<FrameShape<8U, false, false, false, true>>();
+    ExpectShapeMatchesGenericPath<FrameShape<12U, true, false, true>>();
+    ExpectShapeMatchesGenericPath<FrameShape<64U, false, true, false>>();
+#endif
+}
+
+TEST(SpIOpen_FrameShape, FallsBackToGenericPath) {
+    using Shape = FrameShape<8U>;
+    uint8_t payload[MAX_CC_PAYLOAD_SIZE];
+
+    // a frame of another shape is written by WriteFrame()
+    const Frame other = MakeFrame(3U, true, false, false, false, payload);
+    ASSERT_FALSE(Shape::Matches(other));
+    uint8_t expected[MAX_CAN_CC_FRAME_SIZE];
+    etl::byte_stream_writer expected_stream(etl::span<uint8_t>(expected, sizeof(expected)), etl::endian::big);
+    ASSERT_TRUE(frame_writer::WriteFrame(expected_stream, other));
+    uint8_t buffer[MAX_CAN_CC_FRAME_SIZE];
+    etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+    ASSERT_TRUE(frame_writer::WriteShapedFrame<Shape>(stream, other));
+    ASSERT_EQ(stream.size_bytes(), expected_stream.size_bytes());
+    EXPECT_EQ(std::memcmp(buffer, expected, stream.size_bytes()), 0);
+
+    // ...and read by ReadFrame()
+    etl::byte_stream_reader reader(buffer, stream.size_bytes(), etl::endian::big);
+    Frame read{};
+    ASSERT_TRUE(frame_reader::ReadShapedFrame<Shape>(reader, read));
+    EXPECT_EQ(read.can_identifier, other.can_identifier);
+    EXPECT_EQ(read.payload.size(), 3U);
+    EXPECT_EQ(reader.available_bytes(), 0U);
+
+    // a buffer too short for the shape fails as WriteFrame() does
+    const Frame frame = MakeFrame(8U, false, false, false, false, payload);
+    etl::byte_stream_writer short_stream(etl::span<uint8_t>(buffer, Shape::FRAME_LENGTH - 1U), etl::endian::big);
+    auto written = frame_writer::WriteShapedFrame<Shape>(short_stream, frame);
+    ASSERT_FALSE(written);
+    EXPECT_EQ(written.error(), frame_writer::FrameWriteError::BufferTooShort);
+    EXPECT_EQ(short_stream.size_bytes(), 0U);
+
+    uint8_t wire[MAX_CAN_CC_FRAME_SIZE];
+    etl::byte_stream_writer wire_stream(etl::span<uint8_t>(wire, sizeof(wire)), etl::endian::big);
+    ASSERT_TRUE(frame_writer::WriteShapedFrame<Shape>(wire_stream, frame));
+
+    // a corrupted payload fails the CRC, with the error and stream position of ReadFrame()
+    uint8_t corrupted[MAX_CAN_CC_FRAME_SIZE];
+    std::memcpy(corrupted, wire, Shape::FRAME_LENGTH);
+    corrupted[Shape::PAYLOAD_POSITION] ^= 0x01U;
+    etl::byte_stream_reader shaped_reader(corrupted, Shape::FRAME_LENGTH, etl::endian::big);
+    etl::byte_stream_reader generic_reader(corrupted, Shape::FRAME_LENGTH, etl::endian::big);
+    auto shaped = frame_reader::ReadShapedFrame<Shape>(shaped_reader, read);
+    auto generic = frame_reader::ReadFrame(generic_reader, read);
+    ASSERT_FALSE(shaped);
+    ASSERT_FALSE(generic);
+    EXPECT_EQ(shaped.error(), frame_reader::FrameParseError::CrcMismatch);
+    EXPECT_EQ(shaped_reader.available_bytes(), generic_reader.available_bytes());
+
+    // a single bit error in the format header is corrected by ReadFrame(); the CRC is taken over the flipped header,
+    // as the error came before it
+    std::memcpy(corrupted, wire, Shape::FRAME_LENGTH);
+    corrupted[PREAMBLE_SIZE + 1U] ^= 0x10U;
+    const uint16_t crc = algorithms::ComputeCrc16(
+        etl::span<const uint8_t>(corrupted + PREAMBLE_SIZE, Shape::CRC_POSITION - PREAMBLE_SIZE));
+    corrupted[Shape::CRC_POSITION] = static_cast<uint8_t>(crc >> 8U);
+    corrupted[Shape::CRC_POSITION + 1U] = static_cast<uint8_t>(crc);
+    etl::byte_stream_reader corrected_reader(corrupted, Shape::FRAME_LENGTH, etl::endian::big);
+    auto corrected = frame_reader::ReadShapedFrame<Shape>(corrected_reader, read);
+    ASSERT_TRUE(corrected);
+    EXPECT_TRUE(corrected->dlc_corrected);
+    EXPECT_EQ(read.payload.size(), 8U);
+
+    // a frame cut short is reported as ReadFrame() reports it
+    etl::byte_stream_reader truncated(wire, Shape::FRAME_LENGTH - 1U, etl::endian::big);
+    auto cut = frame_reader::ReadShapedFrame<Shape>(truncated, read);
+    ASSERT_FALSE(cut);
+    EXPECT_EQ(cut.error(), frame_reader::FrameParseError::BufferTooShortForPayload);
+}
@@ -0,0 +1,190 @@
+#include <etl/byte_stream.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "spiopen_frame.h"
+#include "spiopen_frame_algorithms.h"
+#include "spiopen_frame_format.h"
+#include "spiopen_frame_reader.h"
+#include "spiopen_frame_statistics.h"
+#include "spiopen_frame_stream_parser.h"
+#include "spiopen_frame_test_helpers.h"
+#include "spiopen_frame_view.h"
+#include "spiopen_frame_writer.h"
+
+#ifdef CONFIG_SPIOPEN_FRAME_READER_STATISTICS
+
+using namespace spiopen;
+using namespace spiopen::format;
+using namespace spiopen::frame_reader;
+using namespace spiopen::test_helpers;
+
+namespace {
+
+std::vector<uint8_t> EncodeFrame(Frame frame, size_t payload_size) {
+    static uint8_t payload[MAX_XL_PAYLOAD_SIZE] = {0};
+    for (size_t i = 0U; i < payload_size; ++i) {
+        payload[i] = static_cast<uint8_t>(i * 3U + 1U);
+    }
+    frame.payload = etl::span<uint8_t>(payload, payload_size);
+    std::vector<uint8_t> encoded = test_helpers::EncodeFrame(frame);
+    EXPECT_FALSE(encoded.empty());
+    return encoded;
+}
+
+void ExpectSameStatistics(const ReaderStatistics& actual, const ReaderStatistics& expected) {
+    EXPECT_EQ(actual.cc_frames, expected.cc_frames);
+    EXPECT_EQ(actual.fd_frames, expected.fd_frames);
+    EXPECT_EQ(actual.xl_frames, expected.xl_frames);
+    EXPECT_EQ(actual.frame_bytes, expected.frame_bytes);
+    EXPECT_EQ(actual.corrected_headers, expected.corrected_headers);
+    EXPECT_EQ(actual.parse_errors, expected.parse_errors);
+    EXPECT_EQ(actual.bit_slips, expected.bit_slips);
+    EXPECT_EQ(actual.resync_bytes, expected.resync_bytes);
+}
+
+}  // namespace
+
+TEST(SpIOpen_FrameStatistics, CountsReads) {
+    ResetReaderStatistics();
+    ReaderStatistics expected{};
+    Frame frame{};
+
+    Frame cc{};
+    cc.can_identifier = 0x123U;
+    std::vector<uint8_t> cc_wire = EncodeFrame(cc, 5U);
+    etl::byte_stream_reader cc_reader(cc_wire.data(), cc_wire.size(), etl::endian::big);
+    ASSERT_TRUE(ReadFrame(cc_reader, frame));
+    ++expected.cc_frames;
+    expected.frame_bytes += cc_wire.size();
+    ++expected.bit_slips[0];
+
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
+    Frame fd{};
+    fd.can_flags.FDF = 1;
+    fd.can_flags.IDE = 1;
+    fd.can_identifier = 0x1ABCDEFU;
+    std::vector<uint8_t> fd_wire = EncodeFrame(fd, 20U);
+    etl::byte_stream_reader fd_reader(fd_wire.data(), fd_wire.size(), etl::endian::big);
+    FrameView view;
+    ASSERT_TRUE(ReadFrameView(fd_reader, view));
+    ++expected.fd_frames;
+    expected.frame_bytes += fd_wire.size();
+    ++expected.bit_slips[0];
+#endif
+
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    Frame xl{};
+    xl.can_flags.FDF = 1;
+    xl.can_flags.XLF = 1;
+    xl.can_identifier = 0x7FFU;
+    std::vector<uint8_t> xl_slipped = BitSlip(EncodeFrame(xl, 300U), 5U);
+    std::vector<uint8_t> destination(MAX_CAN_XL_FRAME_SIZE);
+    etl::byte_stream_reader xl_reader(xl_slipped.data(), xl_slipped.size(), etl::endian::big);
+    ASSERT_TRUE(ReadAndCopyFrame(xl_reader, etl::span<uint8_t>(destination.data(), destination.size()), frame, 5U));
+    ++expected.xl_frames;
+    expected.frame_bytes += xl_slipped.size() - 1U;
+    ++expected.bit_slips[5];
+#endif
+
+    // a single bit error in the format header (with the CRC taken over it, as the error came before the CRC) is
+    // corrected and counted; a bit error in the payload fails the CRC
+    std::vector<uint8_t> corrected = cc_wire;
+    corrected[PREAMBLE_SIZE + 1U] ^= 0x04U;
+    const size_t crc_start = corrected.size() - SHORT_CRC_SIZE;
+    const uint16_t crc = algorithms::ComputeCrc16(
+        etl::span<const uint8_t>(corrected.data() + PREAMBLE_SIZE, crc_start - PREAMBLE_SIZE));
+    corrected[crc_start] = static_cast<uint8_t>(crc >> 8U);
+    corrected[crc_start + 1U] = static_cast<uint8_t>(crc);
+    etl::byte_stream_reader corrected_reader(corrected.data(), corrected.size(), etl::endian::big);
+    auto ret = ReadFrame(corrected_reader, frame);
+    ASSERT_TRUE(ret);
+    ASSERT_TRUE(ret->dlc_corrected);
+    ++expected.cc_frames;
+    expected.frame_bytes += cc_wire.size();
+    ++expected.corrected_headers;
+    ++expected.bit_slips[0];
+
+    std::vector<uint8_t> corrupted = cc_wire;
+    corrupted[cc_wire.size() - 4U] ^= 0x10U;
+    etl::byte_stream_reader corrupted_reader(corrupted.data(), corrupted.size(), etl::endian::big);
+    ret = ReadFrame(corrupted_reader, frame);
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(ret.error(), FrameParseError::CrcMismatch);
+    ++expected.parse_errors[static_cast<size_t>(FrameParseError::CrcMismatch)];
+
+    etl::byte_stream_reader truncated_reader(cc_wire.data(), 3U, etl::endian::big);
+    ASSERT_FALSE(ReadFrame(truncated_reader, frame));
+    ++expected.parse_errors[static_cast<size_t>(FrameParseError::BufferTooShortToDetermineLength)];
+
+    // sizing a frame is not reading one
+    ASSERT_TRUE(PeekFrameLength(etl::span<const uint8_t>(cc_wire.data(), cc_wire.size())));
+
+    const ReaderStatistics statistics = GetReaderStatistics();
+    ExpectSameStatistics(statistics, expected);
+    EXPECT_EQ(statistics.GetParseErrorCount(FrameParseError::CrcMismatch), 1U);
+
+    ResetReaderStatistics();
+    ExpectSameStatistics(GetReaderStatistics(), ReaderStatistics{});
+}
+
+TEST(SpIOpen_FrameStatistics, ParseAllAndStreamParserAgree) {
+    Frame a{};
+    a.can_identifier = 0x12U;
+    Frame b{};
+    b.can_identifier = 0x34U;
+    Frame c{};
+    c.can_identifier = 0x56U;
+    c.can_flags.TTL = 1;
+    const std::vector<uint8_t> a_wire = EncodeFrame(a, 3U);
+    std::vector<uint8_t> b_wire = EncodeFrame(b, 8U);
+    b_wire[b_wire.size() - 1U] ^= 0x01U;  // fails its CRC
+    const std::vector<uint8_t> c_slipped = BitSlip(EncodeFrame(c, 2U), 3U);
+    const std::vector<uint8_t> d_wire = EncodeFrame(a, 1U);
+
+    // idle gaps of 5, 3, 4 and 2 bytes; the last byte of the slipped frame C also holds idle bits
+    std::vector<uint8_t> capture(5U, 0U);
+    capture.insert(capture.end(), a_wire.begin(), a_wire.end());
+    capture.insert(capture.end(), 3U, 0U);
+    capture.insert(capture.end(), b_wire.begin(), b_wire.end());
+    capture.insert(capture.end(), 4U, 0U);
+    capture.insert(capture.end(), c_slipped.begin(), c_slipped.end());
+    capture.insert(capture.end(), 2U, 0U);
+    capture.insert(capture.end(), d_wire.begin(), d_wire.end());
+
+    ReaderStatistics expected{};
+    expected.cc_frames = 3U;
+    expected.frame_bytes = a_wire.size() + (c_slipped.size() - 1U) + d_wire.size();
+    expected.parse_errors[static_cast<size_t>(FrameParseError::CrcMismatch)] = 1U;
+    expected.bit_slips[0] = 2U;
+    expected.bit_slips[3] = 1U;
+    expected.resync_bytes = 5U + 3U + b_wire.size() + 4U + 3U;
+
+    ResetReaderStatistics();
+    std::vector<uint8_t> scratch(MAX_CAN_XL_FRAME_SIZE);
+    FrameDescriptor descriptors[8] = {};
+    const ParseAllResult result = ParseAll(etl::span<uint8_t>(capture.data(), capture.size()),
+                                           etl::span<FrameDescriptor>(descriptors, 8U),
+                                           etl::span<uint8_t>(scratch.data(), scratch.size()));
+    ASSERT_EQ(result.descriptor_count, 4U);
+    ExpectSameStatistics(GetReaderStatistics(), expected);
+
+    // the same capture fed a few bytes at a time
+    ResetReaderStatistics();
+    FrameStreamParser parser(etl::span<uint8_t>(scratch.data(), scratch.size()));
+    size_t frames = 0U;
+    for (size_t position = 0U; position < capture.size();) {
+        const size_t chunk_size = (capture.size() - position < 7U) ? capture.size() - position : 7U;
+        const FeedResult fed = parser.Feed(etl::span<const uint8_t>(capture.data() + position, chunk_size));
+        position += fed.bytes_consumed;
+        frames += (fed.status == FeedStatus::NeedMoreData) ? 0U : 1U;
+    }
+    EXPECT_EQ(frames, 4U);
+    ExpectSameStatistics(GetReaderStatistics(), expected);
+    ResetReaderStatistics();
+}
+
+#endif
@@ -0,0 +1,290 @@
+#include <etl/byte_stream.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "spiopen_frame.h"
+#include "spiopen_frame_format.h"
+#include "spiopen_frame_reader.h"
+#include "spiopen_frame_stream_parser.h"
+#include "spiopen_frame_test_helpers.h"
+#include "spiopen_frame_writer.h"
+
+using namespace spiopen;
+using namespace spiopen::format;
+using namespace spiopen::frame_reader;
+using namespace spiopen::test_helpers;
+
+namespace {
+
+struct TestFrame {
+    std::vector<uint8_t> payload;
+    Frame frame;
+};
+
+// CC, FD (extended ID, TTL, word aligned) and, when enabled, XL frames
+std::vector<TestFrame> MakeTestFrames() {
+    std::vector<TestFrame> frames;
+    TestFrame cc;
+    cc.payload = {0x01, 0x02, 0x03};
+    cc.frame.can_identifier = 0x12U;
+    frames.push_back(cc);
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
+    TestFrame fd;
+    for (size_t i = 0U; i < 20U; ++i) {
+        fd.payload.push_back(static_cast<uint8_t>(0xA0U + i));
+    }
+    fd.frame.can_identifier = 0x1ABCDEFU;
+    fd.frame.can_flags.IDE = 1;
+    fd.frame.can_flags.FDF = 1;
+    fd.frame.can_flags.TTL = 1;
+    fd.frame.can_flags.WA = 1;
+    fd.frame.time_to_live = 9U;
+    frames.push_back(fd);
+#endif
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    TestFrame xl;
+    for (size_t i = 0U; i < 300U; ++i) {
+        xl.payload.push_back(static_cast<uint8_t>(i * 7U));
+    }
+    xl.frame.can_identifier = 0x3FFU;
+    xl.frame.can_flags.FDF = 1;
+    xl.frame.can_flags.XLF = 1;
+    xl.frame.can_flags.TTL = 1;
+    xl.frame.time_to_live = 3U;
+    xl.frame.xl_control.payload_type = 0x42U;
+    xl.frame.xl_control.virtual_can_network_id = 0x07U;
+    xl.frame.xl_control.addressing_field = 0xDEADBEEFU;
+    frames.push_back(xl);
+#endif
+    return frames;
+}
+
+// Encode the frames back to back with idle_bytes of idle_value before each one
+std::vector<uint8_t> EncodeStream(std::vector<TestFrame>& frames, const size_t idle_bytes,
+                                  const uint8_t idle_value = 0x00U) {
+    std::vector<uint8_t> stream;
+    for (TestFrame& test_frame : frames) {
+        test_frame.frame.payload = etl::span<uint8_t>(test_frame.payload.data(), test_frame.payload.size());
+        stream.insert(stream.end(), idle_bytes, idle_value);
+        EXPECT_TRUE(AppendEncodedFrame(test_frame.frame, stream));
+    }
+    stream.insert(stream.end(), idle_bytes, idle_value);
+    return stream;
+}
+
+void ExpectSameFrame(const Frame& actual, const TestFrame& expected, const std::string& context) {
+    EXPECT_EQ(actual.can_identifier, expected.frame.can_identifier) << context;
+    EXPECT_EQ(actual.can_flags.IDE, expected.frame.can_flags.IDE) << context;
+    EXPECT_EQ(actual.can_flags.FDF, expected.frame.can_flags.FDF) << context;
+    EXPECT_EQ(actual.can_flags.XLF, expected.frame.can_flags.XLF) << context;
+    EXPECT_EQ(actual.can_flags.TTL, expected.frame.can_flags.TTL) << context;
+    EXPECT_EQ(actual.can_flags.WA, expected.frame.can_flags.WA) << context;
+    if (expected.frame.can_flags.TTL) {
+        EXPECT_EQ(actual.time_to_live, expected.frame.time_to_live) << context;
+    }
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+    if (expected.frame.can_flags.XLF) {
+        EXPECT_EQ(actual.xl_control.payload_type, expected.frame.xl_control.payload_type) << context;
+        EXPECT_EQ(actual.xl_control.virtual_can_network_id, expected.frame.xl_control.virtual_can_network_id)
+            << context;
+        EXPECT_EQ(actual.xl_control.addressing_field, expected.frame.xl_control.addressing_field) << context;
+    }
+#endif
+    ASSERT_GE(actual.payload.size(), expected.payload.size()) << context;
+    EXPECT_EQ(0, std::memcmp(actual.payload.data(), expected.payload.data(), expected.payload.size())) << context;
+}
+
+}  // namespace
+
+TEST(SpIOpen_FrameStreamParser, FramesAcrossChunksAtEveryBitSlip) {
+    std::vector<TestFrame> frames = MakeTestFrames();
+    const std::vector<uint8_t> stream = EncodeStream(frames, 3U);
+    std::vector<uint8_t> frame_buffer(MAX_CAN_XL_FRAME_SIZE, 0U);
+
+    for (uint8_t slip = 0U; slip < 8U; ++slip) {
+        const std::vector<uint8_t> slipped = BitSlip(stream, slip);
+        for (const size_t chunk_size : {size_t{1U}, size_t{2U}, size_t{5U}, size_t{16U}, size_t{61U}, slipped.size()}) {
+            const std::string context =
+                "slip " + std::to_string(slip) + " chunk size " + std::to_string(chunk_size);
+            FrameStreamParser parser(etl::span<uint8_t>(frame_buffer.data(), frame_buffer.size()));
+            size_t frames_found = 0U;
+            for (size_t offset = 0U; offset < slipped.size(); offset += chunk_size) {
+                const size_t length = (slipped.size() - offset < chunk_size) ? slipped.size() - offset : chunk_size;
+                etl::span<const uint8_t> chunk(slipped.data() + offset, length);
+                while (!chunk.empty()) {
+                    const FeedResult result = parser.Feed(chunk);
+                    ASSERT_LE(result.bytes_consumed, chunk.size()) << context;
+                    ASSERT_NE(result.status, FeedStatus::FrameDropped)
+                        << context << " error " << static_cast<int>(result.error);
+                    if (result.status == FeedStatus::FrameComplete) {
+                        ASSERT_LT(frames_found, frames.size()) << context;
+                        ExpectSameFrame(parser.GetFrame(), frames[frames_found], context);
+                        EXPECT_EQ(parser.GetBitSlipCount(), slip) << context;
+                        EXPECT_FALSE(parser.GetReadResult().dlc_corrected) << context;
+                        ++frames_found;
+                    } else {
+                        EXPECT_EQ(result.bytes_consumed, chunk.size()) << context;
+                    }
+                    chunk = chunk.subspan(result.bytes_consumed);
+                }
+            }
+            EXPECT_EQ(frames_found, frames.size()) << context;
+            EXPECT_FALSE(parser.IsReceivingFrame()) << context;
+        }
+    }
+}
+
+TEST(SpIOpen_FrameStreamParser, BackToBackSlippedFrames) {
+    // no idle bytes: a slipped frame ends part way through the byte that starts the next preamble
+    std::vector<TestFrame> frames = MakeTestFrames();
+    const std::vector<uint8_t> stream = EncodeStream(frames, 0U);
+    std::vector<uint8_t> frame_buffer(MAX_CAN_XL_FRAME_SIZE, 0U);
+
+    for (uint8_t slip = 0U; slip < 8U; ++slip) {
+        const std::vector<uint8_t> slipped = BitSlip(stream, slip);
+        FrameStreamParser parser(etl::span<uint8_t>(frame_buffer.data(), frame_buffer.size()));
+        etl::span<const uint8_t> remaining(slipped.data(), slipped.size());
+        size_t frames_found = 0U;
+        while (!remaining.empty()) {
+            const FeedResult result = parser.Feed(remaining);
+            ASSERT_NE(result.status, FeedStatus::FrameDropped) << "slip " << static_cast<int>(slip);
+            if (result.status == FeedStatus::FrameComplete) {
+                ASSERT_LT(frames_found, frames.size());
+                ExpectSameFrame(parser.GetFrame(), frames[frames_found], "slip " + std::to_string(slip));
+                ++frames_found;
+            }
+            remaining = remaining.subspan(result.bytes_consumed);
+        }
+        EXPECT_EQ(frames_found, frames.size()) << "slip " << static_cast<int>(slip);
+    }
+}
+
+TEST(SpIOpen_FrameStreamParser, PreambleAtSeveralSlips) {
+    // idle bytes ending in preamble bits make the preamble fit at a slip before the frame's own; the parser has to fall
+    // back to the frame's slip, as ParseAll() does. Idle bits that form a preamble an even number of bits before the
+    // frame's are a separate preamble, which is dropped before the frame is found.
+    std::vector<uint8_t> frame_buffer(MAX_CAN_XL_FRAME_SIZE, 0U);
+    std::vector<uint8_t> scratch(MAX_CAN_XL_FRAME_SIZE, 0U);
+    for (const uint8_t idle_value : {uint8_t{0x02U}, uint8_t{0x56U}, uint8_t{0x2AU}, uint8_t{0xEAU}}) {
+        for (const size_t idle_bytes : {size_t{0U}, size_t{1U}, size_t{3U}}) {
+            std::vector<TestFrame> frames = MakeTestFrames();
+            TestFrame short_cc;
+            short_cc.payload = {0x10, 0x20, 0x30, 0x40};
+            short_cc.frame.can_identifier = 0x7FFU;
+            frames.insert(frames.begin(), short_cc);
+            std::vector<uint8_t> stream = EncodeStream(frames, idle_bytes, idle_value);
+            if (idle_bytes == 0U) {
+                stream.insert(stream.begin(), idle_value);
+            }
+
+            for (uint8_t slip = 0U; slip < 8U; ++slip) {
+                const std::vector<uint8_t> slipped = BitSlip(stream, slip);
+                for (const size_t chunk_size : {size_t{1U}, size_t{3U}, slipped.size()}) {
+                    const std::string context = "idle " + std::to_string(idle_value) + " x" +
+                                                std::to_string(idle_bytes) + " slip " + std::to_string(slip) +
+                                                " chunk size " + std::to_string(chunk_size);
+                    FrameStreamParser parser(etl::span<uint8_t>(frame_buffer.data(), frame_buffer.size()));
+                    size_t frames_found = 0U;
+                    size_t frames_dropped = 0U;
+                    for (size_t offset = 0U; offset < slipped.size(); offset += chunk_size) {
+                        const size_t length =
+                            (slipped.size() - offset < chunk_size) ? slipped.size() - offset : chunk_size;
+                        etl::span<const uint8_t> chunk(slipped.data() + offset, length);
+                        FeedResult result;
+                        do {  // a completed frame may leave bytes in the parser, so feed until it needs more
+                            result = parser.Feed(chunk);
+                            if (result.status == FeedStatus::FrameDropped) {
+                                ++frames_dropped;
+                            }
+                            if (result.status == FeedStatus::FrameComplete) {
+                                ASSERT_LT(frames_found, frames.size()) << context;
+                                ExpectSameFrame(parser.GetFrame(), frames[frames_found], context);
+                                EXPECT_EQ(parser.GetBitSlipCount(), slip) << context;
+                                ++frames_found;
+                            }
+                            chunk = chunk.subspan(result.bytes_consumed);
+                        } while (result.status != FeedStatus::NeedMoreData);
+                    }
+                    EXPECT_EQ(frames_found, frames.size()) << context;
+                    if (slip == 0U) {
+                        EXPECT_EQ(frames_dropped, 0U) << context << ": only one preamble before each frame";
+                    }
+                }
+
+                // ParseAll finds the same frames at the same slip
+                std::vector<uint8_t> capture = slipped;
+                std::vector<FrameDescriptor> descriptors(16U);
+                const ParseAllResult parsed =
+                    ParseAll(etl::span<uint8_t>(capture.data(), capture.size()),
+                             etl::span<FrameDescriptor>(descriptors.data(), descriptors.size()),
+                             etl::span<uint8_t>(scratch.data(), scratch.size()));
+                size_t valid = 0U;
+                for (size_t i = 0U; i < parsed.descriptor_count; ++i) {
+                    if (descriptors[i].valid) {
+                        EXPECT_EQ(descriptors[i].bit_slip_count, slip);
+                        ++valid;
+                    }
+                }
+                EXPECT_EQ(valid, frames.size()) << "ParseAll, slip " << static_cast<int>(slip);
+            }
+        }
+    }
+}
+
+TEST(SpIOpen_FrameStreamParser, DroppedFrames) {
+    std::vector<TestFrame> frames = MakeTestFrames();
+    std::vector<uint8_t> stream = EncodeStream(frames, 2U);
+    std::vector<uint8_t> frame_buffer(MAX_CAN_XL_FRAME_SIZE, 0U);
+
+    {
+        // a corrupted payload byte in the first frame drops it with a CRC mismatch; the following frames still parse
+        std::vector<uint8_t> corrupted = stream;
+        corrupted[2U + PREAMBLE_SIZE + FORMAT_HEADER_SIZE + CAN_IDENTIFIER_SIZE] ^= 0x10U;
+        FrameStreamParser parser(etl::span<uint8_t>(frame_buffer.data(), frame_buffer.size()));
+        etl::span<const uint8_t> remaining(corrupted.data(), corrupted.size());
+        size_t frames_found = 0U;
+        size_t frames_dropped = 0U;
+        while (!remaining.empty()) {
+            const FeedResult result = parser.Feed(remaining);
+            if (result.status == FeedStatus::FrameDropped) {
+                EXPECT_EQ(result.error, FrameParseError::CrcMismatch);
+                EXPECT_FALSE(parser.IsReceivingFrame());
+                ++frames_dropped;
+            } else if (result.status == FeedStatus::FrameComplete) {
+                ExpectSameFrame(parser.GetFrame(), frames[frames_found + 1U], "after dropped frame");
+                ++frames_found;
+            }
+            remaining = remaining.subspan(result.bytes_consumed);
+        }
+        EXPECT_EQ(frames_dropped, 1U);
+        EXPECT_EQ(frames_found, frames.size() - 1U);
+    }
+
+    {
+        // a frame buffer too small for the frame drops it as soon as the length is known
+        uint8_t small_buffer[8] = {0};
+        FrameStreamParser parser(etl::span<uint8_t>(small_buffer, sizeof(small_buffer)));
+        const FeedResult result = parser.Feed(etl::span<const uint8_t>(stream.data(), stream.size()));
+        EXPECT_EQ(result.status, FeedStatus::FrameDropped);
+        EXPECT_EQ(result.error, FrameParseError::BufferTooShortForPayload);
+        EXPECT_EQ(result.bytes_consumed, 2U)
+            << "dropped right after the format header, which is handed back to be searched again";
+    }
+
+    {
+        // Reset() abandons a partial frame
+        FrameStreamParser parser(etl::span<uint8_t>(frame_buffer.data(), frame_buffer.size()));
+        FeedResult result = parser.Feed(etl::span<const uint8_t>(stream.data(), 8U));
+        EXPECT_EQ(result.status, FeedStatus::NeedMoreData);
+        EXPECT_TRUE(parser.IsReceivingFrame());
+        parser.Reset();
+        EXPECT_FALSE(parser.IsReceivingFrame());
+        result = parser.Feed(etl::span<const uint8_t>(stream.data() + 8U, stream.size() - 8U));
+        ASSERT_EQ(result.status, FeedStatus::FrameComplete) << "the rest of the first frame is skipped";
+        ExpectSameFrame(parser.GetFrame(), frames[1U], "after reset");
+    }
+}
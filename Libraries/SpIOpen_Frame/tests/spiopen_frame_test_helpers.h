@@ -0,0 +1,73 @@
+/*
+SpIOpen Frame Test Helpers : Encoding and bit slip helpers shared by the tests and benchmarks.
+
+Copyright 2026 Andrew Burks, Burks Engineering
+SPDX-License-Identifier: Apache-2.0
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "etl/byte_stream.h"
+#include "etl/span.h"
+#include "spiopen_frame.h"
+#include "spiopen_frame_format.h"
+#include "spiopen_frame_writer.h"
+
+namespace spiopen::test_helpers {
+
+/**
+ * @brief Simulate a receiver that clocked in bit_slip_count extra bits before the data: every byte is shifted right and
+ * the low bits spill into the next byte.
+ * @param source The bytes as sent
+ * @param length Number of bytes in source
+ * @param slipped Receives the bytes as received; length + 1 bytes are written
+ * @param bit_slip_count Number of extra bits (0 to 7)
+ */
+inline void BitSlipBuffer(const uint8_t* source, const size_t length, uint8_t* slipped, const uint8_t bit_slip_count) {
+    uint8_t previous = 0U;
+    for (size_t i = 0U; i <= length; ++i) {
+        const uint8_t current = (i < length) ? source[i] : 0U;
+        slipped[i] = (bit_slip_count == 0U)
+                         ? current
+                         : static_cast<uint8_t>((previous << (8U - bit_slip_count)) | (current >> bit_slip_count));
+        previous = current;
+    }
+}
+
+/**
+ * @brief BitSlipBuffer() into a new vector, one byte longer than source.
+ */
+inline std::vector<uint8_t> BitSlip(const std::vector<uint8_t>& source, const uint8_t bit_slip_count) {
+    std::vector<uint8_t> slipped(source.size() + 1U, 0U);
+    BitSlipBuffer(source.data(), source.size(), slipped.data(), bit_slip_count);
+    return slipped;
+}
+
+/**
+ * @brief Encode a frame with WriteFrame() onto the end of wire.
+ * @return True on success; on failure wire is left as it was
+ */
+inline bool AppendEncodedFrame(const Frame& frame, std::vector<uint8_t>& wire) {
+    const size_t start = wire.size();
+    wire.resize(start + format::MAX_CAN_XL_FRAME_SIZE, 0U);
+    etl::byte_stream_writer writer(etl::span<uint8_t>(wire.data() + start, format::MAX_CAN_XL_FRAME_SIZE),
+                                   etl::endian::big);
+    const bool written = frame_writer::WriteFrame(writer, frame).has_value();
+    wire.resize(start + (written ? writer.size_bytes() : 0U));
+    return written;
+}
+
+/**
+ * @brief Encode a frame with WriteFrame() into a new vector.
+ * @return The encoded frame, or an empty vector if it could not be written
+ */
+inline std::vector<uint8_t> EncodeFrame(const Frame& frame) {
+    std::vector<uint8_t> wire;
+    AppendEncodedFrame(frame, wire);
+    return wire;
+}
+
+}  // namespace spiopen::test_helpers
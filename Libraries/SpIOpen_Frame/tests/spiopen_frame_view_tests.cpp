@@ -0,0 +1,146 @@
+#include <etl/byte_stream.h>
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "spiopen_frame.h"
+#include "spiopen_frame_format.h"
+#include "spiopen_frame_reader.h"
+#include "spiopen_frame_view.h"
+#include "spiopen_frame_writer.h"
+
+using namespace spiopen;
+using namespace spiopen::format;
+using namespace spiopen::frame_reader;
+
+TEST(SpIOpen_FrameView, MatchesReadFrame) {
+    uint8_t payload[64];
+    for (size_t i = 0U; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>(i * 5U + 1U);
+    }
+    for (size_t payload_size : {0U, 3U, 8U, 20U, 64U}) {
+        for (uint8_t flags = 0U; flags < 16U; ++flags) {
+            Frame frame{};
+            frame.can_flags.IDE = flags & 0x1U;
+            frame.can_flags.TTL = (flags >> 1U) & 0x1U;
+            frame.can_flags.WA = (flags >> 2U) & 0x1U;
+            frame.can_flags.RTR = (flags >> 3U) & 0x1U;
+            frame.can_flags.BRS = (flags >> 3U) & 0x1U;
+            frame.can_flags.FDF = (payload_size > MAX_CC_PAYLOAD_SIZE) ? 1 : 0;
+            frame.can_identifier = frame.can_flags.IDE ? 0x1ABCDEFU : 0x5A5U;
+            frame.time_to_live = 7U;
+            frame.payload = etl::span<uint8_t>(payload, payload_size);
+            uint8_t buffer[MAX_CAN_FD_FRAME_SIZE + 4U] = {0};
+            etl::byte_stream_writer writer(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+            ASSERT_TRUE(frame_writer::WriteFrame(writer, frame));
+
+            etl::byte_stream_reader frame_reader(buffer, writer.size_bytes(), etl::endian::big);
+            Frame read_frame{};
+            ASSERT_TRUE(ReadFrame(frame_reader, read_frame));
+
+            etl::byte_stream_reader view_reader(buffer, sizeof(buffer), etl::endian::big);
+            FrameView view;
+            auto ret = ReadFrameView(view_reader, view);
+            ASSERT_TRUE(ret) << "payload size " << payload_size << " flags " << static_cast<int>(flags);
+            EXPECT_FALSE(ret->dlc_corrected);
+            ASSERT_TRUE(view.IsValid());
+            EXPECT_EQ(view_reader.used_data().size(), writer.size_bytes()) << "the stream is left after the frame";
+            EXPECT_EQ(view.GetWireBytes().data(), buffer);
+            EXPECT_EQ(view.GetWireBytes().size(), writer.size_bytes());
+
+            EXPECT_EQ(view.GetCanIdentifier(), read_frame.can_identifier);
+            EXPECT_EQ(view.GetTimeToLive(), read_frame.time_to_live);
+            const Frame::Flags view_flags = view.GetFlags();
+            EXPECT_EQ(view_flags.RTR, read_frame.can_flags.RTR);
+            EXPECT_EQ(view_flags.BRS, read_frame.can_flags.BRS);
+            EXPECT_EQ(view_flags.IDE, read_frame.can_flags.IDE);
+            EXPECT_EQ(view_flags.FDF, read_frame.can_flags.FDF);
+            EXPECT_EQ(view_flags.TTL, read_frame.can_flags.TTL);
+            EXPECT_EQ(view_flags.WA, read_frame.can_flags.WA);
+            EXPECT_EQ(view.GetPayload().data(), read_frame.payload.data()) << "the payload is not copied";
+            EXPECT_EQ(view.GetPayload().size(), read_frame.payload.size());
+
+            Frame view_frame{};
+            view.ToFrame(view_frame);
+            EXPECT_EQ(view_frame.can_identifier, read_frame.can_identifier);
+            EXPECT_EQ(view_frame.time_to_live, read_frame.time_to_live);
+            EXPECT_EQ(view_frame.payload.data(), read_frame.payload.data());
+            EXPECT_EQ(view_frame.payload.size(), read_frame.payload.size());
+        }
+    }
+}
+
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+TEST(SpIOpen_FrameView, XlControl) {
+    uint8_t payload[300];
+    for (size_t i = 0U; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>(i);
+    }
+    Frame frame{};
+    frame.can_flags.FDF = 1;
+    frame.can_flags.XLF = 1;
+    frame.can_flags.TTL = 1;
+    frame.can_identifier = 0x3FFU;
+    frame.time_to_live = 2U;
+    frame.xl_control.payload_type = 0x42U;
+    frame.xl_control.virtual_can_network_id = 0x07U;
+    frame.xl_control.addressing_field = 0xDEADBEEFU;
+    frame.payload = etl::span<uint8_t>(payload, sizeof(payload));
+    uint8_t buffer[MAX_CAN_XL_FRAME_SIZE] = {0};
+    etl::byte_stream_writer writer(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+    ASSERT_TRUE(frame_writer::WriteFrame(writer, frame));
+
+    etl::byte_stream_reader reader(buffer, writer.size_bytes(), etl::endian::big);
+    FrameView view;
+    ASSERT_TRUE(ReadFrameView(reader, view));
+    EXPECT_EQ(view.GetCanIdentifier(), 0x3FFU);
+    EXPECT_EQ(view.GetTimeToLive(), 2U);
+    EXPECT_EQ(view.GetFlags().XLF, 1U);
+    const Frame::XLControl xl_control = view.GetXlControl();
+    EXPECT_EQ(xl_control.payload_type, 0x42U);
+    EXPECT_EQ(xl_control.virtual_can_network_id, 0x07U);
+    EXPECT_EQ(xl_control.addressing_field, 0xDEADBEEFU);
+    ASSERT_EQ(view.GetPayload().size(), sizeof(payload));
+    EXPECT_EQ(0, std::memcmp(view.GetPayload().data(), payload, sizeof(payload)));
+}
+#endif
+
+TEST(SpIOpen_FrameView, RejectsWhatReadFrameRejects) {
+    uint8_t payload[5] = {1U, 2U, 3U, 4U, 5U};
+    Frame frame{};
+    frame.can_identifier = 0x123U;
+    frame.can_flags.WA = 1;
+    frame.payload = etl::span<uint8_t>(payload, sizeof(payload));
+    uint8_t encoded[MAX_CAN_CC_FRAME_SIZE] = {0};
+    etl::byte_stream_writer writer(etl::span<uint8_t>(encoded, sizeof(encoded)), etl::endian::big);
+    ASSERT_TRUE(frame_writer::WriteFrame(writer, frame));
+    const size_t frame_length = writer.size_bytes();
+
+    // every single bit flip (corrected in the format header, a CRC mismatch elsewhere) and every truncation gives the
+    // same result in both readers
+    for (size_t bit = 0U; bit <= frame_length * 8U; ++bit) {
+        for (const size_t length : {frame_length, bit / 8U}) {
+            uint8_t buffer[MAX_CAN_CC_FRAME_SIZE] = {0};
+            std::memcpy(buffer, encoded, frame_length);
+            if (length == frame_length && bit < frame_length * 8U) {
+                buffer[bit / 8U] ^= static_cast<uint8_t>(0x80U >> (bit % 8U));
+            }
+            etl::byte_stream_reader frame_reader(buffer, length, etl::endian::big);
+            Frame read_frame{};
+            auto expected = ReadFrame(frame_reader, read_frame);
+            etl::byte_stream_reader view_reader(buffer, length, etl::endian::big);
+            FrameView view;
+            auto ret = ReadFrameView(view_reader, view);
+            ASSERT_EQ(ret.has_value(), expected.has_value()) << "bit " << bit << " length " << length;
+            EXPECT_EQ(view.IsValid(), ret.has_value());
+            if (ret) {
+                EXPECT_EQ(ret->dlc_corrected, expected->dlc_corrected);
+                EXPECT_EQ(view.GetCanIdentifier(), read_frame.can_identifier);
+            } else {
+                EXPECT_EQ(ret.error(), expected.error()) << "bit " << bit << " length " << length;
+            }
+        }
+    }
+}
@@ -7,6 +7,7 @@
 
 #include "spiopen_frame.h"
 #include "spiopen_frame_format.h"
+#include "spiopen_frame_reader.h"
 #include "spiopen_frame_writer.h"
 
 using namespace spiopen;
@@ -626,67 +627,531 @@ TEST(SpIOpen_FrameWriter, WriteCrc) {
 
 TEST(SpIOpen_FrameWriter, WriteFramePadding) {
     {
+        // Preamble, header, CAN ID, TTL and CRC make 9 bytes: one padding byte, wherever the frame starts
         Frame frame{};
         frame.can_flags.WA = 1;
-        uint8_t buffer[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
-        etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
-        stream.write_unchecked(static_cast<uint8_t>(0));
-        stream.write_unchecked(static_cast<uint8_t>(0));
-        stream.write_unchecked(static_cast<uint8_t>(0));
-        auto ret = WriteFramePadding(stream, frame);
-        ASSERT_TRUE(ret) << "WriteFramePadding should succeed when word align and odd length";
-        EXPECT_EQ(stream.size_bytes(), 3U + MAX_PADDING_SIZE);
-        EXPECT_EQ(buffer[3], 0);
+        frame.can_flags.TTL = 1;
+        for (const size_t written : {3U, 4U}) {
+            uint8_t buffer[8] = {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF};
+            etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+            stream.skip<uint8_t>(written);
+            auto ret = WriteFramePadding(stream, frame);
+            ASSERT_TRUE(ret) << "WriteFramePadding should succeed when word align and odd frame length";
+            EXPECT_EQ(stream.size_bytes(), written + 1U);
+            EXPECT_EQ(buffer[written], 0);
+        }
     }
 
     {
         Frame frame{};
         frame.can_flags.WA = 0;
+        frame.can_flags.TTL = 1;
         uint8_t buffer[8] = {0};
         etl::byte_stream_writer stream(etl::span<uint8_t>(buffer + 5, 3U), etl::endian::big);
-        stream.write_unchecked(static_cast<uint8_t>(0));
-        stream.write_unchecked(static_cast<uint8_t>(0));
-        stream.write_unchecked(static_cast<uint8_t>(0));
+        stream.skip<uint8_t>(3U);
         auto ret = WriteFramePadding(stream, frame);
         ASSERT_TRUE(ret) << "WriteFramePadding should succeed when word align disabled";
         EXPECT_EQ(stream.size_bytes(), 3U);
     }
 
     {
+        // Preamble, header, CAN ID and CRC make 8 bytes: no padding, even at an odd stream position
         Frame frame{};
         frame.can_flags.WA = 1;
         uint8_t buffer[8] = {0};
         etl::byte_stream_writer stream(etl::span<uint8_t>(buffer + 2, 6U), etl::endian::big);
-        stream.write_unchecked(static_cast<uint16_t>(0));
+        stream.skip<uint8_t>(3U);
         auto ret = WriteFramePadding(stream, frame);
-        ASSERT_TRUE(ret) << "WriteFramePadding should succeed when length already even";
-        EXPECT_EQ(stream.size_bytes(), 2U);
+        ASSERT_TRUE(ret) << "WriteFramePadding should succeed when frame length already even";
+        EXPECT_EQ(stream.size_bytes(), 3U);
     }
 
     {
-        // Stream with 3 bytes written (odd length after preamble) and 0 free: must write 1 padding byte but cannot.
+        // Stream with 3 bytes written and 0 free: must write 1 padding byte but cannot.
         Frame frame{};
         frame.can_flags.WA = 1;
+        frame.can_flags.TTL = 1;
         uint8_t buffer[3] = {0};
         etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, 3U), etl::endian::big);
-        stream.write_unchecked(static_cast<uint8_t>(0));
-        stream.write_unchecked(static_cast<uint8_t>(0));
-        stream.write_unchecked(static_cast<uint8_t>(0));
+        stream.skip<uint8_t>(3U);
         auto ret = WriteFramePadding(stream, frame);
         EXPECT_FALSE(ret) << "WriteFramePadding should fail when no room for padding byte";
         EXPECT_EQ(ret.error(), FrameWriteError::BufferTooShort);
     }
 
     {
-        // Stream with 1 byte written and 0 free (cursor at end): current_length underflows; implementation may or may
-        // not try to write.
+        // Stream with 1 byte written and 0 free (cursor at end of a sub-span of the buffer).
         Frame frame{};
         frame.can_flags.WA = 1;
+        frame.can_flags.TTL = 1;
         uint8_t buffer[5] = {0};
         etl::byte_stream_writer stream(etl::span<uint8_t>(buffer + 4, 1U), etl::endian::big);
-        stream.write_unchecked(static_cast<uint8_t>(0));
+        stream.skip<uint8_t>(1U);
         auto ret = WriteFramePadding(stream, frame);
         EXPECT_FALSE(ret) << "WriteFramePadding should fail when no room at cursor";
         EXPECT_EQ(ret.error(), FrameWriteError::BufferTooShort);
     }
 }
+
+TEST(SpIOpen_FrameWriter, DecrementTimeToLiveInPlace) {
+    static uint8_t payload[MAX_XL_PAYLOAD_SIZE];
+    for (size_t i = 0U; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>((i * 7U) ^ (i >> 3U));
+    }
+
+    struct Case {
+        size_t payload_size;
+        bool IDE;
+        bool FDF;
+        bool XLF;
+        bool WA;
+        uint8_t time_to_live;
+    };
+    const Case cases[] = {
+        {0U, false, false, false, false, 5U}, {3U, true, false, false, true, 1U}, {8U, false, false, false, true, 0x80U},
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
+        {9U, false, true, false, true, 0xFFU}, {64U, true, true, false, false, 2U},
+#endif
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+        {65U, false, true, true, true, 3U},    {MAX_XL_PAYLOAD_SIZE - 1U, true, true, true, false, 0x10U},
+#endif
+    };
+
+    for (const Case& c : cases) {
+        Frame frame{};
+        frame.can_identifier = c.IDE ? 0x1234567U : 0x123U;
+        frame.can_flags.IDE = c.IDE;
+        frame.can_flags.FDF = c.FDF;
+        frame.can_flags.XLF = c.XLF;
+        frame.can_flags.WA = c.WA;
+        frame.can_flags.TTL = 1;
+        frame.time_to_live = c.time_to_live;
+        frame.payload = etl::span<uint8_t>(payload, c.payload_size);
+
+        static uint8_t forwarded[MAX_CAN_XL_FRAME_SIZE];
+        etl::byte_stream_writer forwarded_stream(etl::span<uint8_t>(forwarded, sizeof(forwarded)), etl::endian::big);
+        ASSERT_TRUE(WriteFrame(forwarded_stream, frame)) << "payload size " << c.payload_size;
+        const size_t frame_length = forwarded_stream.size_bytes();
+
+        auto ret = DecrementTimeToLiveInPlace(etl::span<uint8_t>(forwarded, frame_length), frame);
+        ASSERT_TRUE(ret) << "DecrementTimeToLiveInPlace should succeed for payload size " << c.payload_size;
+        EXPECT_EQ(*ret, c.time_to_live == 1U) << "expired flag for payload size " << c.payload_size;
+        EXPECT_EQ(frame.time_to_live, c.time_to_live - 1U);
+
+        // the patched frame must be identical to a frame written with the decremented counter
+        static uint8_t expected[MAX_CAN_XL_FRAME_SIZE];
+        etl::byte_stream_writer expected_stream(etl::span<uint8_t>(expected, sizeof(expected)), etl::endian::big);
+        ASSERT_TRUE(WriteFrame(expected_stream, frame));
+        ASSERT_EQ(expected_stream.size_bytes(), frame_length);
+        EXPECT_EQ(memcmp(forwarded, expected, frame_length), 0)
+            << "patched frame differs from re-written frame for payload size " << c.payload_size;
+    }
+
+    {
+        // An expired counter is left alone, a frame without TTL is not touched
+        uint8_t cc_payload[2] = {1U, 2U};
+        Frame frame{};
+        frame.can_flags.TTL = 1;
+        frame.time_to_live = 0U;
+        frame.payload = etl::span<uint8_t>(cc_payload, sizeof(cc_payload));
+        uint8_t buffer[MAX_CAN_CC_FRAME_SIZE];
+        etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+        ASSERT_TRUE(WriteFrame(stream, frame));
+        uint8_t original[MAX_CAN_CC_FRAME_SIZE];
+        memcpy(original, buffer, sizeof(buffer));
+
+        auto ret = DecrementTimeToLiveInPlace(etl::span<uint8_t>(buffer, stream.size_bytes()), frame);
+        ASSERT_TRUE(ret);
+        EXPECT_TRUE(*ret) << "expired counter should report expired";
+        EXPECT_EQ(memcmp(buffer, original, sizeof(buffer)), 0) << "expired counter should not be changed";
+
+        frame.can_flags.TTL = 0;
+        ret = DecrementTimeToLiveInPlace(etl::span<uint8_t>(buffer, stream.size_bytes()), frame);
+        ASSERT_TRUE(ret);
+        EXPECT_FALSE(*ret) << "frame without TTL never expires";
+        EXPECT_EQ(memcmp(buffer, original, sizeof(buffer)), 0) << "frame without TTL should not be changed";
+
+        frame.can_flags.TTL = 1;
+        frame.time_to_live = 4U;
+        ret = DecrementTimeToLiveInPlace(etl::span<uint8_t>(buffer, stream.size_bytes() - 1U), frame);
+        EXPECT_FALSE(ret) << "DecrementTimeToLiveInPlace should fail when the buffer is shorter than the frame";
+        EXPECT_EQ(ret.error(), FrameWriteError::BufferTooShort);
+    }
+}
+
+TEST(SpIOpen_FrameWriter, WriteFrameMatchesFieldWriters) {
+    static uint8_t payload[MAX_XL_PAYLOAD_SIZE];
+    for (size_t i = 0U; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>((i * 11U) ^ (i >> 2U));
+    }
+    size_t payload_sizes[] = {0U, 1U, 5U, 8U,
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
+                              9U, 13U, 33U, 64U,
+#endif
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+                              65U, 130U, MAX_XL_PAYLOAD_SIZE - 1U,
+#endif
+    };
+    for (const size_t payload_size : payload_sizes) {
+        for (uint8_t flags = 0U; flags < 32U; ++flags) {
+            Frame frame{};
+            frame.can_flags.IDE = (flags & 0x01U) != 0U;
+            frame.can_flags.TTL = (flags & 0x02U) != 0U;
+            frame.can_flags.WA = (flags & 0x04U) != 0U;
+            frame.can_flags.RTR = (flags & 0x08U) != 0U;
+            frame.can_flags.BRS = (flags & 0x10U) != 0U;
+            frame.can_flags.FDF = payload_size > MAX_CC_PAYLOAD_SIZE;
+            frame.can_flags.XLF = payload_size > MAX_FD_PAYLOAD_SIZE;
+            frame.can_identifier = frame.can_flags.IDE ? 0x1ABCDEFU : 0x5A5U;
+            frame.time_to_live = 9U;
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+            frame.xl_control.payload_type = 0x42U;
+            frame.xl_control.virtual_can_network_id = 0x07U;
+            frame.xl_control.addressing_field = 0xDEADBEEFU;
+#endif
+            frame.payload = etl::span<uint8_t>(payload, payload_size);
+
+            // the frame written field by field, with the CRC over what was written, and by WriteFrame, at an odd
+            // offset too: the WA padding depends on the frame length, not the stream position
+            size_t frame_length = 0U;
+            static uint8_t expected[MAX_CAN_XL_FRAME_SIZE];
+            for (const size_t offset : {0U, 1U}) {
+                static uint8_t field_buffer[MAX_CAN_XL_FRAME_SIZE + 1U];
+                etl::byte_stream_writer expected_stream(etl::span<uint8_t>(field_buffer, sizeof(field_buffer)),
+                                                        etl::endian::big);
+                expected_stream.skip<uint8_t>(offset);
+                ASSERT_TRUE(WritePreamble(expected_stream));
+                ASSERT_TRUE(WriteFormatHeader(expected_stream, frame));
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+                if (frame.can_flags.XLF) {
+                    ASSERT_TRUE(WriteXlDataAndControl(expected_stream, frame));
+                }
+#endif
+                ASSERT_TRUE(WriteCanIdentifier(expected_stream, frame));
+                ASSERT_TRUE(WriteTimeToLive(expected_stream, frame));
+                ASSERT_TRUE(WritePayload(expected_stream, frame));
+                ASSERT_TRUE(WriteFramePadding(expected_stream, frame));
+                const size_t crc_region_size = expected_stream.size_bytes() - offset - PREAMBLE_SIZE;
+                ASSERT_TRUE(WriteCrc(expected_stream, frame,
+                                     etl::span<const uint8_t>(field_buffer + offset + PREAMBLE_SIZE, crc_region_size)));
+                if (offset == 0U) {
+                    frame_length = expected_stream.size_bytes();
+                    std::memcpy(expected, field_buffer, frame_length);
+                }
+                ASSERT_EQ(expected_stream.size_bytes(), offset + frame_length) << "payload size " << payload_size;
+                EXPECT_EQ(std::memcmp(field_buffer + offset, expected, frame_length), 0)
+                    << "payload size " << payload_size << " flags " << static_cast<int>(flags) << " offset " << offset;
+
+                static uint8_t buffer[MAX_CAN_XL_FRAME_SIZE + 1U];
+                std::memset(buffer, 0xEE, sizeof(buffer));
+                etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, offset + frame_length), etl::endian::big);
+                stream.skip<uint8_t>(offset);
+                ASSERT_TRUE(WriteFrame(stream, frame)) << "payload size " << payload_size;
+                ASSERT_EQ(stream.size_bytes(), offset + frame_length) << "payload size " << payload_size;
+                EXPECT_EQ(std::memcmp(buffer + offset, expected, frame_length), 0)
+                    << "payload size " << payload_size << " flags " << static_cast<int>(flags) << " offset " << offset;
+            }
+
+            // one byte short is refused before anything is written
+            uint8_t short_buffer[MAX_CAN_XL_FRAME_SIZE];
+            etl::byte_stream_writer short_stream(etl::span<uint8_t>(short_buffer, frame_length - 1U), etl::endian::big);
+            auto ret = WriteFrame(short_stream, frame);
+            ASSERT_FALSE(ret);
+            EXPECT_EQ(ret.error(), FrameWriteError::BufferTooShort);
+            EXPECT_EQ(short_stream.size_bytes(), 0U);
+        }
+    }
+}
+
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+TEST(SpIOpen_FrameWriter, WriteFrameLongestXlPayload) {
+    static uint8_t payload[MAX_XL_PAYLOAD_SIZE];
+    for (size_t i = 0U; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>(i ^ (i >> 8U));
+    }
+    static uint8_t buffer[MAX_CAN_XL_FRAME_SIZE];
+    for (uint8_t flags = 0U; flags < 4U; ++flags) {
+        Frame frame{};
+        frame.can_flags.IDE = (flags & 0x01U) != 0U;
+        frame.can_flags.TTL = (flags & 0x02U) != 0U;
+        frame.can_flags.FDF = 1;
+        frame.can_flags.XLF = 1;
+        frame.can_identifier = frame.can_flags.IDE ? 0x1ABCDEFU : 0x5A5U;
+        frame.time_to_live = 9U;
+
+        // 2047 bytes is the longest length the 11-bit XL data length field encodes, and reads back
+        frame.payload = etl::span<uint8_t>(payload, MAX_XL_PAYLOAD_SIZE - 1U);
+        etl::byte_stream_writer writer(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+        ASSERT_TRUE(WriteFrame(writer, frame)) << "flags " << static_cast<int>(flags);
+        etl::byte_stream_reader reader(buffer, writer.size_bytes(), etl::endian::big);
+        Frame read_frame{};
+        auto read = frame_reader::ReadFrame(reader, read_frame);
+        ASSERT_TRUE(read) << "flags " << static_cast<int>(flags) << " error " << static_cast<int>(read.error());
+        ASSERT_EQ(read_frame.payload.size(), MAX_XL_PAYLOAD_SIZE - 1U);
+        EXPECT_EQ(std::memcmp(read_frame.payload.data(), payload, MAX_XL_PAYLOAD_SIZE - 1U), 0);
+
+        // 2048 bytes would go on the wire as length 0, so every writer rejects it
+        frame.payload = etl::span<uint8_t>(payload, MAX_XL_PAYLOAD_SIZE);
+        etl::byte_stream_writer rejected(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+        auto written = WriteFrame(rejected, frame);
+        ASSERT_FALSE(written) << "WriteFrame should reject a 2048-byte XL payload";
+        EXPECT_EQ(written.error(), FrameWriteError::InvalidPayloadLength);
+        EXPECT_EQ(rejected.size_bytes(), 0U);
+        auto validated = ValidateFrame(rejected, frame);
+        ASSERT_FALSE(validated);
+        EXPECT_EQ(validated.error(), FrameWriteError::InvalidPayloadLength);
+        size_t offset = 0U;
+        auto batch = WriteFrames(rejected, etl::span<const Frame>(&frame, 1U), etl::span<size_t>(&offset, 1U),
+                                 BatchWriteOptions{});
+        ASSERT_FALSE(batch);
+        EXPECT_EQ(batch.error(), FrameWriteError::InvalidPayloadLength);
+        FrameSegments segments;
+        auto segmented = WriteFrameSegments(frame, segments);
+        ASSERT_FALSE(segmented);
+        EXPECT_EQ(segmented.error(), FrameWriteError::InvalidPayloadLength);
+        CyclicFrameTemplate frame_template;
+        auto prepared = PrepareFrameTemplate(frame, frame_template);
+        ASSERT_FALSE(prepared);
+        EXPECT_EQ(prepared.error(), FrameWriteError::InvalidPayloadLength);
+    }
+}
+#endif
+
+TEST(SpIOpen_FrameWriter, WriteFrames) {
+    uint8_t payload[MAX_CC_PAYLOAD_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8};
+    Frame frames[4] = {};
+    frames[0].can_identifier = 0x100U;
+    frames[0].payload = etl::span<uint8_t>(payload, 8U);
+    frames[1].can_identifier = 0x1ABCDEFU;
+    frames[1].can_flags.IDE = 1;
+    frames[1].can_flags.WA = 1;
+    frames[1].payload = etl::span<uint8_t>(payload, 3U);
+    frames[2].can_identifier = 0x200U;
+    frames[2].can_flags.TTL = 1;
+    frames[2].time_to_live = 4U;
+    frames[2].payload = etl::span<uint8_t>(payload, 0U);
+    frames[3].can_identifier = 0x300U;
+    frames[3].payload = etl::span<uint8_t>(payload, 1U);
+
+    // each frame on its own, for reference
+    uint8_t single[4][MAX_CAN_CC_FRAME_SIZE];
+    size_t single_length[4];
+    for (size_t i = 0U; i < 4U; ++i) {
+        etl::byte_stream_writer writer(etl::span<uint8_t>(single[i], sizeof(single[i])), etl::endian::big);
+        ASSERT_TRUE(WriteFrame(writer, frames[i]));
+        single_length[i] = writer.size_bytes();
+    }
+
+    const BatchWriteOptions layouts[] = {{0U, 0U, 0x00U}, {4U, 0U, 0x00U}, {1U, 3U, 0xFFU}, {8U, 2U, 0x00U}};
+    for (const BatchWriteOptions& options : layouts) {
+        const size_t alignment = (options.frame_alignment == 0U) ? 1U : options.frame_alignment;
+        auto batch_length = GetBatchLength(etl::span<const Frame>(frames, 4U), options);
+        ASSERT_TRUE(batch_length);
+
+        // one byte of something else in front, so the batch does not start at the start of the buffer
+        uint8_t buffer[4U * (MAX_CAN_CC_FRAME_SIZE + 8U) + 1U];
+        std::memset(buffer, 0xEE, sizeof(buffer));
+        etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+        ASSERT_TRUE(stream.write(static_cast<uint8_t>(0x5AU)));
+        size_t offsets[4];
+        auto ret = WriteFrames(stream, etl::span<const Frame>(frames, 4U), etl::span<size_t>(offsets, 4U), options);
+        ASSERT_TRUE(ret);
+        EXPECT_EQ(*ret, *batch_length);
+        EXPECT_EQ(stream.size_bytes(), 1U + *ret);
+
+        const uint8_t* const batch = buffer + 1U;
+        size_t position = 0U;
+        for (size_t i = 0U; i < 4U; ++i) {
+            EXPECT_EQ(offsets[i] % alignment, 0U);
+            if (i == 0U) {
+                EXPECT_EQ(offsets[i], 0U);
+            } else {
+                EXPECT_GE(offsets[i], position + options.inter_frame_gap);
+                EXPECT_LT(offsets[i], position + options.inter_frame_gap + alignment)
+                    << "the gap is no longer than needed";
+            }
+            for (size_t j = position; j < offsets[i]; ++j) {
+                EXPECT_EQ(batch[j], options.idle_byte);
+            }
+            EXPECT_EQ(std::memcmp(batch + offsets[i], single[i], single_length[i]), 0) << "frame " << i;
+            position = offsets[i] + single_length[i];
+        }
+        EXPECT_EQ(position, *ret) << "the batch ends with the last frame";
+        EXPECT_EQ(batch[*ret], 0xEEU);
+
+        // a stream one byte short, or too few offsets, is refused and the stream is not moved on
+        etl::byte_stream_writer short_stream(etl::span<uint8_t>(buffer, *ret - 1U), etl::endian::big);
+        ret = WriteFrames(short_stream, etl::span<const Frame>(frames, 4U), etl::span<size_t>(offsets, 4U), options);
+        ASSERT_FALSE(ret);
+        EXPECT_EQ(ret.error(), FrameWriteError::BufferTooShort);
+        EXPECT_EQ(short_stream.size_bytes(), 0U);
+        etl::byte_stream_writer full_stream(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+        ret = WriteFrames(full_stream, etl::span<const Frame>(frames, 4U), etl::span<size_t>(offsets, 3U), options);
+        ASSERT_FALSE(ret);
+        EXPECT_EQ(ret.error(), FrameWriteError::BufferTooShort);
+        EXPECT_EQ(full_stream.size_bytes(), 0U);
+    }
+
+    // an invalid frame fails the batch with its error, and the stream is not moved on
+    Frame invalid[2] = {frames[0], frames[1]};
+    uint8_t long_payload[MAX_CC_PAYLOAD_SIZE + 1U] = {0};
+    invalid[1].payload = etl::span<uint8_t>(long_payload, sizeof(long_payload));
+    auto length = GetBatchLength(etl::span<const Frame>(invalid, 2U), BatchWriteOptions{});
+    ASSERT_FALSE(length);
+    EXPECT_EQ(length.error(), FrameWriteError::InvalidPayloadLength);
+    uint8_t buffer[2U * MAX_CAN_CC_FRAME_SIZE];
+    etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+    size_t offsets[2];
+    auto ret = WriteFrames(stream, etl::span<const Frame>(invalid, 2U), etl::span<size_t>(offsets, 2U),
+                           BatchWriteOptions{});
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(ret.error(), FrameWriteError::InvalidPayloadLength);
+    EXPECT_EQ(stream.size_bytes(), 0U);
+
+    // an empty batch is empty
+    length = GetBatchLength(etl::span<const Frame>(), BatchWriteOptions{4U, 2U, 0x00U});
+    ASSERT_TRUE(length);
+    EXPECT_EQ(*length, 0U);
+}
+
+TEST(SpIOpen_FrameWriter, WriteFrameSegments) {
+    static uint8_t payload[MAX_XL_PAYLOAD_SIZE];
+    for (size_t i = 0U; i < sizeof(payload); ++i) {
+        payload[i] = static_cast<uint8_t>((i * 7U) + 3U);
+    }
+    size_t payload_sizes[] = {0U, 1U, 8U,
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
+                              9U, 49U, 64U,
+#endif
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+                              65U, 1001U,
+#endif
+    };
+    for (const size_t payload_size : payload_sizes) {
+        for (uint8_t flags = 0U; flags < 8U; ++flags) {
+            Frame frame{};
+            frame.can_flags.IDE = (flags & 0x01U) != 0U;
+            frame.can_flags.TTL = (flags & 0x02U) != 0U;
+            frame.can_flags.WA = (flags & 0x04U) != 0U;
+            frame.can_flags.FDF = payload_size > MAX_CC_PAYLOAD_SIZE;
+            frame.can_flags.XLF = payload_size > MAX_FD_PAYLOAD_SIZE;
+            frame.can_identifier = frame.can_flags.IDE ? 0x1234567U : 0x321U;
+            frame.time_to_live = 17U;
+            frame.payload = etl::span<uint8_t>(payload, payload_size);
+
+            static uint8_t expected[MAX_CAN_XL_FRAME_SIZE];
+            etl::byte_stream_writer stream(etl::span<uint8_t>(expected, sizeof(expected)), etl::endian::big);
+            ASSERT_TRUE(WriteFrame(stream, frame));
+
+            FrameSegments segments;
+            ASSERT_TRUE(WriteFrameSegments(frame, segments));
+            const etl::span<const FrameSegment> list = segments.GetSegments();
+            ASSERT_EQ(list.size(), (payload_size == 0U) ? 2U : 3U);
+            if (payload_size > 0U) {
+                EXPECT_EQ(list[1].data, payload) << "the payload is borrowed, not copied";
+                EXPECT_EQ(list[1].length, payload_size);
+            }
+            // the segments, one after the other, are the frame WriteFrame() writes
+            size_t position = 0U;
+            for (const FrameSegment& segment : list) {
+                ASSERT_LE(position + segment.length, stream.size_bytes());
+                EXPECT_EQ(std::memcmp(segment.data, expected + position, segment.length), 0)
+                    << "payload size " << payload_size << " flags " << static_cast<int>(flags);
+                position += segment.length;
+            }
+            EXPECT_EQ(position, stream.size_bytes());
+            EXPECT_EQ(segments.GetFrameLength(), stream.size_bytes());
+        }
+    }
+
+    // an invalid frame leaves the segments empty
+    uint8_t long_payload[MAX_CC_PAYLOAD_SIZE + 1U] = {0};
+    Frame frame{};
+    frame.payload = etl::span<uint8_t>(long_payload, sizeof(long_payload));
+    FrameSegments segments;
+    auto ret = WriteFrameSegments(frame, segments);
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(ret.error(), FrameWriteError::InvalidPayloadLength);
+    EXPECT_TRUE(segments.GetSegments().empty());
+    EXPECT_EQ(segments.GetFrameLength(), 0U);
+}
+
+TEST(SpIOpen_FrameWriter, CyclicFrameTemplate) {
+    static uint8_t payload[MAX_XL_PAYLOAD_SIZE];
+    size_t payload_sizes[] = {0U, 2U, 8U,
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_FD_ENABLE
+                              12U, 33U, 64U,
+#endif
+#ifdef CONFIG_SPIOPEN_FRAME_CAN_XL_ENABLE
+                              100U, 777U,
+#endif
+    };
+    for (const size_t payload_size : payload_sizes) {
+        for (uint8_t flags = 0U; flags < 16U; ++flags) {
+            Frame frame{};
+            frame.can_flags.IDE = (flags & 0x01U) != 0U;
+            frame.can_flags.TTL = (flags & 0x02U) != 0U;
+            frame.can_flags.WA = (flags & 0x04U) != 0U;
+            frame.can_flags.ESI = (flags & 0x08U) != 0U;
+            frame.can_flags.FDF = payload_size > MAX_CC_PAYLOAD_SIZE;
+            frame.can_flags.XLF = payload_size > MAX_FD_PAYLOAD_SIZE;
+            frame.can_identifier = frame.can_flags.IDE ? 0x0765432U : 0x181U;
+            frame.time_to_live = 3U;
+            frame.payload = etl::span<uint8_t>(payload, payload_size);
+
+            CyclicFrameTemplate frame_template;
+            ASSERT_TRUE(PrepareFrameTemplate(frame, frame_template));
+            EXPECT_EQ(frame_template.GetPayloadSize(), payload_size);
+
+            // a few cycles with a new payload each, against WriteFrame() with the same payload
+            for (uint8_t cycle = 0U; cycle < 3U; ++cycle) {
+                for (size_t i = 0U; i < payload_size; ++i) {
+                    payload[i] = static_cast<uint8_t>((i * 5U) + (cycle * 41U));
+                }
+                static uint8_t expected[MAX_CAN_XL_FRAME_SIZE];
+                etl::byte_stream_writer expected_stream(etl::span<uint8_t>(expected, sizeof(expected)),
+                                                        etl::endian::big);
+                ASSERT_TRUE(WriteFrame(expected_stream, frame));
+                EXPECT_EQ(frame_template.GetFrameLength(), expected_stream.size_bytes());
+
+                static uint8_t buffer[MAX_CAN_XL_FRAME_SIZE];
+                std::memset(buffer, 0xEE, sizeof(buffer));
+                etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+                ASSERT_TRUE(WriteFrame(stream, frame_template, etl::span<const uint8_t>(payload, payload_size)));
+                ASSERT_EQ(stream.size_bytes(), expected_stream.size_bytes());
+                EXPECT_EQ(std::memcmp(buffer, expected, stream.size_bytes()), 0)
+                    << "payload size " << payload_size << " flags " << static_cast<int>(flags) << " cycle "
+                    << static_cast<int>(cycle);
+            }
+
+            // a payload of another length, or a buffer one byte short, is refused
+            uint8_t buffer[MAX_CAN_XL_FRAME_SIZE];
+            etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+            auto ret = WriteFrame(stream, frame_template, etl::span<const uint8_t>(payload, payload_size + 1U));
+            ASSERT_FALSE(ret);
+            EXPECT_EQ(ret.error(), FrameWriteError::InvalidPayloadLength);
+            etl::byte_stream_writer short_stream(etl::span<uint8_t>(buffer, frame_template.GetFrameLength() - 1U),
+                                                 etl::endian::big);
+            ret = WriteFrame(short_stream, frame_template, etl::span<const uint8_t>(payload, payload_size));
+            ASSERT_FALSE(ret);
+            EXPECT_EQ(ret.error(), FrameWriteError::BufferTooShort);
+            EXPECT_EQ(short_stream.size_bytes(), 0U);
+        }
+    }
+
+    // an unprepared template, or one that failed to prepare, writes nothing
+    CyclicFrameTemplate frame_template;
+    uint8_t buffer[MAX_CAN_CC_FRAME_SIZE];
+    etl::byte_stream_writer stream(etl::span<uint8_t>(buffer, sizeof(buffer)), etl::endian::big);
+    auto ret = WriteFrame(stream, frame_template, etl::span<const uint8_t>());
+    ASSERT_FALSE(ret);
+    EXPECT_EQ(ret.error(), FrameWriteError::InvalidFrameLength);
+    uint8_t long_payload[MAX_CC_PAYLOAD_SIZE + 1U] = {0};
+    Frame frame{};
+    frame.payload = etl::span<uint8_t>(long_payload, sizeof(long_payload));
+    auto prepared = PrepareFrameTemplate(frame, frame_template);
+    ASSERT_FALSE(prepared);
+    EXPECT_EQ(prepared.error(), FrameWriteError::InvalidPayloadLength);
+    EXPECT_EQ(frame_template.GetFrameLength(), 0U);
+    EXPECT_EQ(stream.size_bytes(), 0U);
+}